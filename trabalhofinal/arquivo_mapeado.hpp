@@ -0,0 +1,84 @@
+// Arquivo inteiro mapeado na memória, só leitura (usado pelo CSV e pelos formatos binários)
+// Sem mmap (fora de Unix) lê o arquivo pra um buffer e o resto funciona igual.
+#pragma once
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ARQUIVO_MMAP 1
+#endif
+
+class ArquivoMapeado {
+private:
+    const char* base = nullptr;
+    size_t tam = 0;
+    std::vector<char> buffer; // usado quando não tem mmap
+
+public:
+    ArquivoMapeado() = default;
+    ArquivoMapeado(const ArquivoMapeado&) = delete;
+    ArquivoMapeado& operator=(const ArquivoMapeado&) = delete;
+    ArquivoMapeado(ArquivoMapeado&& o) noexcept { *this = std::move(o); }
+    ArquivoMapeado& operator=(ArquivoMapeado&& o) noexcept {
+        if (this != &o) {
+            fechar();
+            base = o.base; tam = o.tam;
+            buffer = std::move(o.buffer);
+            if (!buffer.empty()) base = buffer.data();
+            o.base = nullptr; o.tam = 0;
+        }
+        return *this;
+    }
+    ~ArquivoMapeado() { fechar(); }
+
+    // Retorna false se o arquivo não existir, não abrir ou estiver vazio
+    bool abrir(const std::string& arquivo) {
+        fechar();
+#ifdef ARQUIVO_MMAP
+        int fd = open(arquivo.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) { close(fd); return false; }
+        tam = st.st_size;
+        void* mapa = mmap(nullptr, tam, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapa == MAP_FAILED) { tam = 0; return false; }
+        base = static_cast<const char*>(mapa);
+#else
+        std::ifstream in(arquivo, std::ios::binary);
+        if (!in.is_open()) return false;
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        if (buffer.empty()) return false;
+        base = buffer.data();
+        tam = buffer.size();
+#endif
+        return true;
+    }
+
+    void fechar() {
+#ifdef ARQUIVO_MMAP
+        if (base && buffer.empty()) munmap(const_cast<char*>(base), tam);
+#endif
+        base = nullptr;
+        tam = 0;
+        buffer.clear();
+    }
+
+    // Avisa o sistema que o arquivo vai ser lido do começo ao fim (lê adiantado)
+    void leituraSequencial() {
+#ifdef ARQUIVO_MMAP
+        if (base && buffer.empty()) madvise(const_cast<char*>(base), tam, MADV_SEQUENTIAL);
+#endif
+    }
+
+    const char* dados() const { return base; }
+    size_t tamanho() const { return tam; }
+};
@@ -5,211 +5,36 @@
 #include <fstream>
 #include <chrono>   // pra medir tempo
 #include <iomanip>  // pra formatar saída
+#include <cstdint>
+#include <random>
+#include <cmath>
+#include <limits>
+#include <span>
 
-// Estrutura do nó da árvore AVL
-struct Node {
-    double key;
-    Node *left;
-    Node *right;
-    int height;
-    Node(double k) : key(k), left(nullptr), right(nullptr), height(1) {}
-};
-
-// Classe da árvore AVL
-class AVLTree {
-private:
-    Node* root;
-
-    // Função pra pegar altura do nó
-    int height(Node* N) { return (N == nullptr) ? 0 : N->height; }
-    // Balanceamento
-    int getBalance(Node* N) { return (N == nullptr) ? 0 : height(N->left) - height(N->right); }
-
-    // Rotação à direita
-    Node* rightRotate(Node* y) {
-        Node* x = y->left;
-        Node* T2 = x->right;
-        x->right = y;
-        y->left = T2;
-        y->height = std::max(height(y->left), height(y->right)) + 1;
-        x->height = std::max(height(x->left), height(x->right)) + 1;
-        return x;
-    }
-
-    // Rotação à esquerda
-    Node* leftRotate(Node* x) {
-        Node* y = x->right;
-        Node* T2 = y->left;
-        y->left = x;
-        x->right = T2;
-        x->height = std::max(height(x->left), height(x->right)) + 1;
-        y->height = std::max(height(y->left), height(y->right)) + 1;
-        return y;
-    }
-
-    // Inserção recursiva
-    Node* insert(Node* node, double key) {
-        if (node == nullptr) return new Node(key);
-        if (key < node->key) node->left = insert(node->left, key);
-        else node->right = insert(node->right, key);
-
-        node->height = 1 + std::max(height(node->left), height(node->right));
-        int balance = getBalance(node);
-
-        // Verifica os casos de rotação
-        if (balance > 1 && key < node->left->key) return rightRotate(node);
-        if (balance < -1 && key >= node->right->key) return leftRotate(node);
-        if (balance > 1 && key >= node->left->key) {
-            node->left = leftRotate(node->left);
-            return rightRotate(node);
-        }
-        if (balance < -1 && key < node->right->key) {
-            node->right = rightRotate(node->right);
-            return leftRotate(node);
-        }
-        return node;
-    }
-
-    // Pega o nó com menor valor
-    Node* minValueNode(Node* node) {
-        Node* current = node;
-        while (current->left != nullptr) current = current->left;
-        return current;
-    }
-
-    // Remove um nó
-    Node* remove(Node* root, double key) {
-        if (root == nullptr) return root;
-        if (key < root->key) root->left = remove(root->left, key);
-        else if (key > root->key) root->right = remove(root->right, key);
-        else {
-            if ((root->left == nullptr) || (root->right == nullptr)) {
-                Node* temp = root->left ? root->left : root->right;
-                if (temp == nullptr) { temp = root; root = nullptr; }
-                else *root = *temp;
-                delete temp;
-            } else {
-                Node* temp = minValueNode(root->right);
-                root->key = temp->key;
-                root->right = remove(root->right, temp->key);
-            }
-        }
-        if (root == nullptr) return root;
-
-        root->height = 1 + std::max(height(root->left), height(root->right));
-        int balance = getBalance(root);
-
-        // Balanceia se precisar
-        if (balance > 1 && getBalance(root->left) >= 0) return rightRotate(root);
-        if (balance > 1 && getBalance(root->left) < 0) {
-            root->left = leftRotate(root->left);
-            return rightRotate(root);
-        }
-        if (balance < -1 && getBalance(root->right) <= 0) return leftRotate(root);
-        if (balance < -1 && getBalance(root->right) > 0) {
-            root->right = rightRotate(root->right);
-            return leftRotate(root);
-        }
-        return root;
-    }
-
-    // Preenche um vetor com os valores em ordem
-    void inorderToList(Node* root, std::vector<double>& list) {
-        if (root != nullptr) {
-            inorderToList(root->left, list);
-            list.push_back(root->key);
-            inorderToList(root->right, list);
-        }
-    }
-
-    // Busca todos os valores no intervalo [x, y]
-    void rangeQueryRec(Node* node, double x, double y, std::vector<double>& res) {
-        if (node == nullptr) return;
-        if (x < node->key) rangeQueryRec(node->left, x, y, res);
-        if (node->key >= x && node->key <= y) res.push_back(node->key);
-        if (y > node->key) rangeQueryRec(node->right, x, y, res);
-    }
-
-public:
-
-    AVLTree() : root(nullptr) {}
-    void insert(double value) { root = insert(root, value); }
-    void remove(double value) { root = remove(root, value); }
-
-    // Gera lista ordenada (pra não gastar tempo imprimindo)
-    void getSortedList(std::vector<double>& list) {
-        inorderToList(root, list);
-    }
-
-    // Calcula a mediana
-    double median() {
-        std::vector<double> list;
-        inorderToList(root, list);
-        if (list.empty()) return 0.0;
-        int n = list.size();
-        if (n % 2 != 0) return list[n / 2];
-        else return (list[n / 2 - 1] + list[n / 2]) / 2.0;
-    }
-
-    // Retorna os n menores
-    std::vector<double> min(int n) {
-        std::vector<double> list;
-        inorderToList(root, list); // não é o mais eficiente, mas funciona
-        std::vector<double> res;
-        for(int i=0; i<n && i < (int)list.size(); i++) res.push_back(list[i]);
-        return res;
-    }
-
-    // Retorna os n maiores
-    std::vector<double> max(int n) {
-        std::vector<double> list;
-        inorderToList(root, list);
-        std::vector<double> res;
-        for(int i=0; i<n && i < (int)list.size(); i++) 
-            res.push_back(list[list.size() - 1 - i]);
-        return res;
-    }
-
-    // Busca todos os valores no intervalo
-    std::vector<double> rangeQuery(double x, double y) {
-        std::vector<double> res;
-        rangeQueryRec(root, x, y, res);
-        return res;
-    }
-
-    // Verifica se a árvore está vazia
-    bool isEmpty() { return root == nullptr; }
-};
+#include "leituras_bin.hpp"
+#include "indices.hpp"
 
 // Main com os testes/benchmarks
 int main() {
     AVLTree avl;
-    std::string filename = "temperaturas.csv";
-    std::ifstream file(filename);
-    std::string line;
-    int count = 0;
-
-    if (!file.is_open()) {
-        std::cerr << "Erro ao abrir " << filename << std::endl;
+    // temperaturas.bin mapeado (sem parse) se existir, senão temperaturas.csv
+    Dataset ds = carregarLeituras("temperaturas");
+    VisaoLeituras valores = ds.valores;
+    if (valores.empty()) {
+        std::cerr << "Nenhuma temperatura em temperaturas.bin/.csv" << std::endl;
         return 1;
     }
+    int count = valores.size();
 
     std::cout << std::fixed << std::setprecision(5);
     std::cout << "==== AVL TREE BENCHMARK ====" << std::endl;
 
     // 1. Inserção dos dados do arquivo
     auto start = std::chrono::high_resolution_clock::now();
-    while (std::getline(file, line)) {
-        try {
-            if (!line.empty() && line.back() == '\r') line.pop_back();
-            avl.insert(std::stod(line));
-            count++;
-        } catch (...) {}
-    }
+    for (double v : valores) avl.insert(v);
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> t_insert = end - start;
     std::cout << "[INSERT] " << count << " registros | Tempo: " << t_insert.count() << " ms" << std::endl;
-    file.close();
 
     if (avl.isEmpty()) return 0;
 
@@ -220,6 +45,14 @@ int main() {
     std::chrono::duration<double, std::milli> t_median = end - start;
     std::cout << "[MEDIAN] Resultado: " << med << " | Tempo: " << t_median.count() << " ms" << std::endl;
 
+    // 2b. Estatísticas de ordem (select/rank/percentil em O(log N))
+    start = std::chrono::high_resolution_clock::now();
+    int abaixo = avl.rank(20.0);
+    double p90 = avl.percentile(90.0);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_rank = end - start;
+    std::cout << "[RANK(20)] " << abaixo << " abaixo de 20 | [P90] " << p90 << " | Tempo: " << t_rank.count() << " ms" << std::endl;
+
     // 3. Menores valores (3 menores)
     start = std::chrono::high_resolution_clock::now();
     std::vector<double> mins = avl.min(3);
@@ -245,6 +78,17 @@ int main() {
     std::chrono::duration<double, std::milli> t_range = end - start;
     std::cout << "[RANGE(20, 25)] Encontrados: " << range.size() << " itens | Tempo: " << t_range.count() << " ms" << std::endl;
 
+    // 5b. Agregados do intervalo sem montar a lista (O(log N))
+    start = std::chrono::high_resolution_clock::now();
+    int rc = avl.rangeCount(20.0, 25.0);
+    double rmean = avl.rangeMean(20.0, 25.0);
+    double rmin = avl.rangeMin(20.0, 25.0);
+    double rmax = avl.rangeMax(20.0, 25.0);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_agg = end - start;
+    std::cout << "[RANGE AGG(20, 25)] qtd " << rc << " | media " << rmean << " | min " << rmin
+              << " | max " << rmax << " | Tempo: " << t_agg.count() << " ms" << std::endl;
+
     // 6. Remover valor (exemplo: 22.5)
     start = std::chrono::high_resolution_clock::now();
     avl.remove(22.5); // só remove se existir
@@ -260,5 +104,78 @@ int main() {
     std::chrono::duration<double, std::milli> t_sort = end - start;
     std::cout << "[PRINTSORTED] Gerada lista de " << sortedList.size() << " itens | Tempo: " << t_sort.count() << " ms" << std::endl;
 
+    // 8. Ponteiros (new/delete) x pool de nós com índices de 32 bits
+    const int N = 1000000;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dis(-1000, 4500); // centésimos de grau
+    std::vector<double> leituras(N);
+    for (double& v : leituras) v = dis(gen) / 100.0;
+
+    AVLTree ptrTree;
+    start = std::chrono::high_resolution_clock::now();
+    for (double v : leituras) ptrTree.insert(v);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_ptr = end - start;
+
+    PooledAVLTree pool;
+    start = std::chrono::high_resolution_clock::now();
+    for (double v : leituras) pool.insert(v);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_pool = end - start;
+
+    // malloc guarda ~16 bytes de cabeçalho por bloco além do sizeof(AVLNode<double>)
+    std::cout << "[POOL] " << N << " insercoes | Ponteiros: " << t_ptr.count() << " ms ("
+              << N / t_ptr.count() / 1000.0 << " M/s, ~" << sizeof(AVLNode<double>) + 16 << " bytes/leitura)"
+              << " | Pool: " << t_pool.count() << " ms ("
+              << N / t_pool.count() / 1000.0 << " M/s, "
+              << (double)pool.bytesUsed() / pool.count() << " bytes/leitura)" << std::endl;
+
+    start = std::chrono::high_resolution_clock::now();
+    pool.clear();
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_clear = end - start;
+    std::cout << "[POOL] clear(): " << t_clear.count() << " ms" << std::endl;
+
+    // 9. Carga em lote: sort + montagem balanceada x N inserções
+    AVLTree bulk;
+    start = std::chrono::high_resolution_clock::now();
+    bulk.bulkLoad(leituras);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_bulk = end - start;
+
+    std::vector<double> loteExtra(leituras.begin(), leituras.begin() + N / 2);
+    start = std::chrono::high_resolution_clock::now();
+    bulk.insertBatch(loteExtra);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_batch = end - start;
+    std::cout << "[BULKLOAD] " << N << " leituras: " << t_bulk.count() << " ms (inserindo 1 a 1: "
+              << t_ptr.count() << " ms) | insertBatch(" << loteExtra.size() << "): "
+              << t_batch.count() << " ms | mediana " << bulk.median() << std::endl;
+
+    // 10. Leituras repetidas: um nó por leitura x um nó por valor distinto (com contador)
+    // As leituras acima têm 2 casas entre -10 e 45, ou seja só 5501 valores possíveis;
+    // as contínuas (sem arredondar) quase não repetem, pra ver o custo quando não ajuda.
+    std::vector<double> continuas(N);
+    std::uniform_real_distribution<double> disC(-10.0, 45.0);
+    for (double& v : continuas) v = disC(gen);
+    for (auto* dados : {&leituras, &continuas}) {
+        AVLTree comum;
+        start = std::chrono::high_resolution_clock::now();
+        for (double v : *dados) comum.insert(v);
+        end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> t_comum = end - start;
+
+        CountedAVLTree contada;
+        start = std::chrono::high_resolution_clock::now();
+        for (double v : *dados) contada.insert(v);
+        end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> t_contada = end - start;
+
+        std::cout << "[REPETIDOS " << (dados == &leituras ? "2 casas" : "continuas") << "] " << N << " insercoes | AVL: "
+                  << comum.count() << " nos, " << comum.bytesUsed() / 1024 << " KB, " << t_comum.count() << " ms"
+                  << " | contador: " << contada.distinctCount() << " nos, " << contada.bytesUsed() / 1024 << " KB, "
+                  << t_contada.count() << " ms | mediana " << comum.median() << " / " << contada.median() << std::endl;
+    }
+
     return 0;
 }
\ No newline at end of file
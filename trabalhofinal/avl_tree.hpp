@@ -0,0 +1,1040 @@
+// Árvores AVL dos benchmarks
+// - AVLTree: nós com ponteiro, tamanho e soma da subárvore (select/rank/percentil
+//   e agregados de intervalo em O(log N)), carga em lote, consultas sem alocação e save/load
+// - CountedAVLTree: um nó por chave distinta com contador de repetições, tudo iterativo
+// - PooledAVLTree: os nós ficam num vetor contíguo com filhos de 32 bits
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <string>
+
+#include "indice.hpp"
+#include "estado_bin.hpp"
+
+// Estrutura do nó da árvore AVL
+template <typename Key>
+struct AVLNode {
+    Key key;
+    AVLNode *left;
+    AVLNode *right;
+    int height;
+    int size;   // qtd de nós na subárvore (pra select/rank)
+    double sum; // soma das chaves da subárvore (pra agregados de intervalo)
+    AVLNode(Key k) : key(k), left(nullptr), right(nullptr), height(1), size(1), sum(k) {}
+};
+
+// Classe da árvore AVL
+template <typename Key = double, typename Compare = std::less<Key>>
+class AVLTree {
+public:
+    using key_type = Key;
+    using key_compare = Compare;
+
+private:
+    using Node = AVLNode<Key>;
+    Node* root;
+    Compare comp;
+
+    // Função pra pegar altura do nó
+    int height(Node* N) { return (N == nullptr) ? 0 : N->height; }
+    // Balanceamento
+    int getBalance(Node* N) { return (N == nullptr) ? 0 : height(N->left) - height(N->right); }
+    // Tamanho da subárvore
+    int size(Node* N) { return (N == nullptr) ? 0 : N->size; }
+    // Soma da subárvore
+    double sum(Node* N) { return (N == nullptr) ? 0.0 : N->sum; }
+
+    // Recalcula altura, tamanho e soma a partir dos filhos
+    void update(Node* N) {
+        N->height = std::max(height(N->left), height(N->right)) + 1;
+        N->size = size(N->left) + size(N->right) + 1;
+        N->sum = sum(N->left) + sum(N->right) + N->key;
+    }
+
+    // Rotação à direita
+    Node* rightRotate(Node* y) {
+        Node* x = y->left;
+        Node* T2 = x->right;
+        x->right = y;
+        y->left = T2;
+        update(y);
+        update(x);
+        return x;
+    }
+
+    // Rotação à esquerda
+    Node* leftRotate(Node* x) {
+        Node* y = x->right;
+        Node* T2 = y->left;
+        y->left = x;
+        x->right = T2;
+        update(x);
+        update(y);
+        return y;
+    }
+
+    // Inserção recursiva
+    Node* insert(Node* node, Key key) {
+        if (node == nullptr) return new Node(key);
+        if (comp(key, node->key)) node->left = insert(node->left, key);
+        else node->right = insert(node->right, key);
+
+        update(node);
+        int balance = getBalance(node);
+
+        // Verifica os casos de rotação
+        if (balance > 1 && comp(key, node->left->key)) return rightRotate(node);
+        if (balance < -1 && !comp(key, node->right->key)) return leftRotate(node);
+        if (balance > 1 && !comp(key, node->left->key)) {
+            node->left = leftRotate(node->left);
+            return rightRotate(node);
+        }
+        if (balance < -1 && comp(key, node->right->key)) {
+            node->right = rightRotate(node->right);
+            return leftRotate(node);
+        }
+        return node;
+    }
+
+    // Pega o nó com menor valor
+    Node* minValueNode(Node* node) {
+        Node* current = node;
+        while (current->left != nullptr) current = current->left;
+        return current;
+    }
+
+    // Remove um nó
+    Node* remove(Node* root, Key key) {
+        if (root == nullptr) return root;
+        if (comp(key, root->key)) root->left = remove(root->left, key);
+        else if (comp(root->key, key)) root->right = remove(root->right, key);
+        else {
+            if ((root->left == nullptr) || (root->right == nullptr)) {
+                Node* temp = root->left ? root->left : root->right;
+                if (temp == nullptr) { temp = root; root = nullptr; }
+                else *root = *temp;
+                delete temp;
+            } else {
+                Node* temp = minValueNode(root->right);
+                root->key = temp->key;
+                root->right = remove(root->right, temp->key);
+            }
+        }
+        if (root == nullptr) return root;
+
+        update(root);
+        int balance = getBalance(root);
+
+        // Balanceia se precisar
+        if (balance > 1 && getBalance(root->left) >= 0) return rightRotate(root);
+        if (balance > 1 && getBalance(root->left) < 0) {
+            root->left = leftRotate(root->left);
+            return rightRotate(root);
+        }
+        if (balance < -1 && getBalance(root->right) <= 0) return leftRotate(root);
+        if (balance < -1 && getBalance(root->right) > 0) {
+            root->right = rightRotate(root->right);
+            return leftRotate(root);
+        }
+        return root;
+    }
+
+    // Libera a subárvore inteira
+    void destroy(Node* node) {
+        if (node == nullptr) return;
+        destroy(node->left);
+        destroy(node->right);
+        delete node;
+    }
+
+    // Preenche um vetor com os valores em ordem
+    void inorderToList(Node* root, std::vector<Key>& list) {
+        if (root != nullptr) {
+            inorderToList(root->left, list);
+            list.push_back(root->key);
+            inorderToList(root->right, list);
+        }
+    }
+
+    // Coloca os ponteiros dos nós em ordem (sem copiar as chaves)
+    void inorderNodes(Node* root, std::vector<Node*>& out) {
+        if (root == nullptr) return;
+        inorderNodes(root->left, out);
+        out.push_back(root);
+        inorderNodes(root->right, out);
+    }
+
+    // Monta uma subárvore perfeitamente balanceada com os nós v[lo, hi): O(N)
+    Node* buildBalanced(std::vector<Node*>& v, int lo, int hi) {
+        if (lo >= hi) return nullptr;
+        int mid = lo + (hi - lo) / 2;
+        Node* node = v[mid];
+        node->left = buildBalanced(v, lo, mid);
+        node->right = buildBalanced(v, mid + 1, hi);
+        update(node);
+        return node;
+    }
+
+    // Acumula quantidade e soma dos valores >= x da subárvore (desce um caminho só)
+    void aggGE(Node* node, Key x, int& c, double& s) {
+        while (node != nullptr) {
+            if (!comp(node->key, x)) {
+                c += size(node->right) + 1;
+                s += sum(node->right) + node->key;
+                node = node->left;
+            } else node = node->right;
+        }
+    }
+
+    // Acumula quantidade e soma dos valores <= y da subárvore
+    void aggLE(Node* node, Key y, int& c, double& s) {
+        while (node != nullptr) {
+            if (!comp(y, node->key)) {
+                c += size(node->left) + 1;
+                s += sum(node->left) + node->key;
+                node = node->right;
+            } else node = node->left;
+        }
+    }
+
+    // Quantidade e soma de [x, y]: acha o nó onde o intervalo se divide e
+    // soma as subárvores inteiras dos dois caminhos. O(log N), sem alocar.
+    void rangeAgg(Key x, Key y, int& c, double& s) {
+        c = 0; s = 0.0;
+        Node* node = root;
+        while (node != nullptr) {
+            if (comp(node->key, x)) node = node->right;
+            else if (comp(y, node->key)) node = node->left;
+            else break;
+        }
+        if (node == nullptr) return;
+        c = 1; s = node->key;
+        aggGE(node->left, x, c, s);
+        aggLE(node->right, y, c, s);
+    }
+
+    // Em ordem dentro de [x, y]; retorna false quando o visitante pediu pra parar
+    // (desce pros dois lados quando a chave é igual ao limite porque repetidos podem estar dos dois lados)
+    template <typename F>
+    bool visitRec(Node* node, Key x, Key y, F& visit) {
+        if (node == nullptr) return true;
+        if (!comp(node->key, x) && !visitRec(node->left, x, y, visit)) return false;
+        if (dentroDoIntervalo(comp, node->key, x, y) && !visit(node->key)) return false;
+        if (!comp(y, node->key)) return visitRec(node->right, x, y, visit);
+        return true;
+    }
+
+    // Os n primeiros do percurso em ordem (Crescente) ou ao contrário, com pilha explícita:
+    // a pilha guarda a borda ainda não visitada (no máximo a altura da árvore)
+    template <bool Crescente>
+    std::vector<Key> ponta(int n) {
+        std::vector<Key> res;
+        if (n <= 0) return res;
+        res.reserve(std::min(n, size(root)));
+        Node* pilha[64]; // altura da AVL < 1.45 log2 N
+        int h = 0;
+        for (Node* m = root; m != nullptr; m = Crescente ? m->left : m->right) pilha[h++] = m;
+        while (h > 0 && (int)res.size() < n) {
+            Node* node = pilha[--h];
+            res.push_back(node->key);
+            for (Node* m = Crescente ? node->right : node->left; m != nullptr; m = Crescente ? m->left : m->right) pilha[h++] = m;
+        }
+        return res;
+    }
+
+public:
+
+    AVLTree() : root(nullptr) {}
+    ~AVLTree() { destroy(root); }
+    AVLTree(const AVLTree&) = delete;
+    AVLTree& operator=(const AVLTree&) = delete;
+
+    void insert(Key value) { root = insert(root, value); }
+    void remove(Key value) { root = remove(root, value); }
+
+    // Gera lista ordenada (pra não gastar tempo imprimindo)
+    void getSortedList(std::vector<Key>& list) {
+        inorderToList(root, list);
+    }
+
+    // Carga em lote: ordena o lote (O(N log N), ou só confere em O(N) se já vier ordenado)
+    // e monta a árvore balanceada em O(N)
+    void bulkLoad(std::span<const Key> batch) {
+        if (root != nullptr) { insertBatch(batch); return; }
+        std::vector<Key> sorted(batch.begin(), batch.end());
+        if (!std::is_sorted(sorted.begin(), sorted.end(), comp)) std::sort(sorted.begin(), sorted.end(), comp);
+        std::vector<Node*> nodes;
+        nodes.reserve(sorted.size());
+        for (Key v : sorted) nodes.push_back(new Node(v));
+        root = buildBalanced(nodes, 0, nodes.size());
+    }
+
+    // Junta um lote numa árvore que já tem dados: intercala com o percurso em ordem
+    // e remonta, sem rotação nenhuma. Se o lote for pequeno, inserir um a um sai mais barato.
+    // Lote já ordenado (a ingestão ordena antes) não é ordenado de novo.
+    void insertBatch(std::span<const Key> batch) {
+        std::vector<Key> sorted(batch.begin(), batch.end());
+        if (!std::is_sorted(sorted.begin(), sorted.end(), comp)) std::sort(sorted.begin(), sorted.end(), comp);
+        int n = size(root);
+        if ((double)sorted.size() * std::log2(n + 2.0) < n) {
+            for (Key v : sorted) insert(v);
+            return;
+        }
+        std::vector<Node*> old;
+        old.reserve(n);
+        inorderNodes(root, old);
+        std::vector<Node*> merged;
+        merged.reserve(old.size() + sorted.size());
+        size_t i = 0, j = 0;
+        while (i < old.size() || j < sorted.size()) {
+            if (j == sorted.size() || (i < old.size() && !comp(sorted[j], old[i]->key))) merged.push_back(old[i++]);
+            else merged.push_back(new Node(sorted[j++]));
+        }
+        root = buildBalanced(merged, 0, merged.size());
+    }
+
+    // Grava os valores em ordem (formato de estado_bin.hpp). Retorna false se não conseguir escrever.
+    bool save(const std::string& arquivo, uint64_t geracaoLog = 0) {
+        std::vector<Key> lista;
+        lista.reserve(size(root));
+        inorderToList(root, lista);
+        return salvarEstado<Key>(arquivo, ESTADO_AVL, lista, 0, geracaoLog);
+    }
+
+    // Troca o conteúdo pelo do arquivo. Os valores já vêm em ordem, então monta a árvore
+    // balanceada direto em O(N), sem ordenar nem rotacionar (só ordena se foi gravado com
+    // outro comparador). Arquivo ausente ou inválido não mexe na árvore.
+    bool load(const std::string& arquivo) {
+        EstadoMapeado<Key> estado;
+        if (!estado.abrir(arquivo, ESTADO_AVL)) return false;
+        std::span<const Key> v = estado.valores();
+        std::vector<Node*> nodes;
+        nodes.reserve(v.size());
+        for (Key k : v) nodes.push_back(new Node(k));
+        if (!std::is_sorted(v.begin(), v.end(), comp))
+            std::sort(nodes.begin(), nodes.end(), [&](Node* a, Node* b) { return comp(a->key, b->key); });
+        destroy(root);
+        root = buildBalanced(nodes, 0, nodes.size());
+        return true;
+    }
+
+    // Quantidade de valores na árvore
+    int count() { return size(root); }
+
+    // Memória dos nós (sem o cabeçalho que o malloc guarda em cada bloco)
+    size_t bytesUsed() { return (size_t)size(root) * sizeof(Node); }
+
+    // k-ésimo menor valor (k começa em 0), desce usando os tamanhos: O(log N)
+    Key select(int k) {
+        Node* node = root;
+        while (node != nullptr) {
+            int l = size(node->left);
+            if (k < l) node = node->left;
+            else if (k == l) return node->key;
+            else { k -= l + 1; node = node->right; }
+        }
+        return Key{};
+    }
+
+    // Quantos valores são menores que x: O(log N)
+    int rank(Key x) {
+        int r = 0;
+        Node* node = root;
+        while (node != nullptr) {
+            if (!comp(node->key, x)) node = node->left;
+            else { r += size(node->left) + 1; node = node->right; }
+        }
+        return r;
+    }
+
+    // Percentil p (0 a 100), interpolando entre os dois vizinhos
+    double percentile(double p) {
+        int n = size(root);
+        if (n == 0) return 0.0;
+        double pos = std::clamp(p, 0.0, 100.0) / 100.0 * (n - 1);
+        int lo = (int)pos;
+        if (lo + 1 >= n) return select(n - 1);
+        double frac = pos - lo;
+        return select(lo) * (1.0 - frac) + select(lo + 1) * frac;
+    }
+
+    // Calcula a mediana em O(log N) (sem gerar a lista inteira)
+    double median() {
+        int n = size(root);
+        if (n == 0) return 0.0;
+        if (n % 2 != 0) return select(n / 2);
+        else return ((double)select(n / 2 - 1) + select(n / 2)) / 2.0;
+    }
+
+    // Retorna os n menores: desce pela borda esquerda e segue o percurso em ordem
+    // só até juntar n, O(log N + n) em vez de montar a lista inteira
+    std::vector<Key> min(int n) { return ponta<true>(n); }
+
+    // Retorna os n maiores (do maior pro menor), pela borda direita
+    std::vector<Key> max(int n) { return ponta<false>(n); }
+
+    // Agregados de intervalo em O(log N), sem montar a lista
+    // (intervalo vazio: rangeMean/rangeMin/rangeMax devolvem NaN, já que 0.0 é temperatura válida)
+    int rangeCount(Key x, Key y) {
+        int c; double s;
+        rangeAgg(x, y, c, s);
+        return c;
+    }
+
+    double rangeSum(Key x, Key y) {
+        int c; double s;
+        rangeAgg(x, y, c, s);
+        return s;
+    }
+
+    double rangeMean(Key x, Key y) {
+        int c; double s;
+        rangeAgg(x, y, c, s);
+        return (c == 0) ? std::numeric_limits<double>::quiet_NaN() : s / c;
+    }
+
+    // Menor valor >= x, se for <= y
+    double rangeMin(Key x, Key y) {
+        Node* best = nullptr;
+        for (Node* node = root; node != nullptr; ) {
+            if (!comp(node->key, x)) { best = node; node = node->left; }
+            else node = node->right;
+        }
+        return (best != nullptr && !comp(y, best->key)) ? (double)best->key : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // Maior valor <= y, se for >= x
+    double rangeMax(Key x, Key y) {
+        Node* best = nullptr;
+        for (Node* node = root; node != nullptr; ) {
+            if (!comp(y, node->key)) { best = node; node = node->right; }
+            else node = node->left;
+        }
+        return (best != nullptr && !comp(best->key, x)) ? (double)best->key : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // Versão sem alocação: chama visit(valor) pra cada valor em [x, y]
+    // em ordem crescente. visit retorna false pra parar antes. Retorna quantos foram visitados.
+    template <typename F>
+    size_t forEachInRange(Key x, Key y, F&& visit) {
+        size_t n = 0;
+        auto counted = [&](Key v) { n++; return visit(v); };
+        visitRec(root, x, y, counted);
+        return n;
+    }
+
+    // Escreve os valores de [x, y] num iterador de saída, parando depois de `limit`
+    template <typename OutIt>
+    OutIt rangeQuery(Key x, Key y, OutIt out, size_t limit = std::numeric_limits<size_t>::max()) {
+        if (limit == 0) return out;
+        size_t n = 0;
+        forEachInRange(x, y, [&](Key v) { *out++ = v; return ++n < limit; });
+        return out;
+    }
+
+    // Busca todos os valores no intervalo (a contagem em O(log N) já dá o tamanho certo)
+    std::vector<Key> rangeQuery(Key x, Key y) {
+        std::vector<Key> res;
+        res.reserve(rangeCount(x, y));
+        forEachInRange(x, y, [&](Key v) { res.push_back(v); return true; });
+        return res;
+    }
+
+    // Verifica se a árvore está vazia
+    bool isEmpty() { return root == nullptr; }
+};
+
+// Nó da AVL com repetição: uma chave e quantas vezes ela apareceu
+template <typename Key>
+struct CountedAVLNode {
+    Key key;
+    CountedAVLNode *left;
+    CountedAVLNode *right;
+    int height;
+    int count;  // repetições dessa chave
+    int size;   // qtd de valores na subárvore (somando as repetições)
+    double sum; // soma dos valores da subárvore
+    CountedAVLNode(Key k, int c) : key(k), left(nullptr), right(nullptr), height(1), count(c), size(c), sum((double)k * c) {}
+};
+
+// AVL multiconjunto: leitura repetida só aumenta o contador do nó (com 2 casas decimais
+// 1 milhão de leituras cabem em ~5500 nós). Inserção, remoção e percursos são iterativos:
+// o caminho vai numa pilha de tamanho fixo (altura da AVL < 1.45 log2 N), sem recursão.
+template <typename Key = double, typename Compare = std::less<Key>>
+class CountedAVLTree {
+public:
+    using key_type = Key;
+    using key_compare = Compare;
+
+private:
+    using Node = CountedAVLNode<Key>;
+    static const int ALTURA_MAX = 64; // sobra: com 2^32 nós a altura fica abaixo de 47
+    Node* root = nullptr;
+    size_t nos = 0; // chaves distintas
+    Compare comp;
+
+    int height(Node* N) { return (N == nullptr) ? 0 : N->height; }
+    int getBalance(Node* N) { return (N == nullptr) ? 0 : height(N->left) - height(N->right); }
+    int size(Node* N) { return (N == nullptr) ? 0 : N->size; }
+    double sum(Node* N) { return (N == nullptr) ? 0.0 : N->sum; }
+
+    void update(Node* N) {
+        N->height = std::max(height(N->left), height(N->right)) + 1;
+        N->size = size(N->left) + size(N->right) + N->count;
+        N->sum = sum(N->left) + sum(N->right) + (double)N->key * N->count;
+    }
+
+    Node* rightRotate(Node* y) {
+        Node* x = y->left;
+        y->left = x->right;
+        x->right = y;
+        update(y);
+        update(x);
+        return x;
+    }
+
+    Node* leftRotate(Node* x) {
+        Node* y = x->right;
+        x->right = y->left;
+        y->left = x;
+        update(x);
+        update(y);
+        return y;
+    }
+
+    // Recalcula o nó e rotaciona se desbalanceou
+    Node* balance(Node* n) {
+        update(n);
+        int b = getBalance(n);
+        if (b > 1) {
+            if (getBalance(n->left) < 0) n->left = leftRotate(n->left);
+            return rightRotate(n);
+        }
+        if (b < -1) {
+            if (getBalance(n->right) > 0) n->right = rightRotate(n->right);
+            return leftRotate(n);
+        }
+        return n;
+    }
+
+    // Percorre os nós em ordem (ou ao contrário) com pilha explícita; visit(nó) retorna false pra parar
+    template <bool Crescente, typename F>
+    void percorrer(F&& visit) {
+        Node* pilha[ALTURA_MAX];
+        int h = 0;
+        for (Node* n = root; n != nullptr; n = Crescente ? n->left : n->right) pilha[h++] = n;
+        while (h > 0) {
+            Node* n = pilha[--h];
+            if (!visit(n)) return;
+            for (Node* m = Crescente ? n->right : n->left; m != nullptr; m = Crescente ? m->left : m->right) pilha[h++] = m;
+        }
+    }
+
+    // Quantidade e soma de [x, y] (mesma ideia da AVLTree, pesando pelo contador)
+    void rangeAgg(Key x, Key y, int& c, double& s) {
+        c = 0; s = 0.0;
+        Node* node = root;
+        while (node != nullptr) {
+            if (comp(node->key, x)) node = node->right;
+            else if (comp(y, node->key)) node = node->left;
+            else break;
+        }
+        if (node == nullptr) return;
+        c = node->count; s = (double)node->key * node->count;
+        for (Node* n = node->left; n != nullptr; ) {
+            if (!comp(n->key, x)) {
+                c += size(n->right) + n->count;
+                s += sum(n->right) + (double)n->key * n->count;
+                n = n->left;
+            } else n = n->right;
+        }
+        for (Node* n = node->right; n != nullptr; ) {
+            if (!comp(y, n->key)) {
+                c += size(n->left) + n->count;
+                s += sum(n->left) + (double)n->key * n->count;
+                n = n->right;
+            } else n = n->left;
+        }
+    }
+
+public:
+    CountedAVLTree() = default;
+    ~CountedAVLTree() { clear(); }
+    CountedAVLTree(const CountedAVLTree&) = delete;
+    CountedAVLTree& operator=(const CountedAVLTree&) = delete;
+
+    // Insere `vezes` cópias do valor. Desce uma vez só já somando tamanho e soma no caminho
+    // (o valor vai ficar embaixo de todos eles de qualquer jeito); se a chave já existe
+    // acabou aí. Senão cria o nó e sobe rebalanceando até a altura parar de mudar.
+    void insert(Key value, int vezes = 1) {
+        if (vezes <= 0) return;
+        Node** caminho[ALTURA_MAX];
+        int h = 0;
+        Node** link = &root;
+        while (*link != nullptr) {
+            Node* n = *link;
+            n->size += vezes;
+            n->sum += (double)value * vezes;
+            if (!comp(value, n->key) && !comp(n->key, value)) { n->count += vezes; return; }
+            caminho[h++] = link;
+            link = comp(value, n->key) ? &n->left : &n->right;
+        }
+        *link = new Node(value, vezes);
+        nos++;
+        while (h > 0) {
+            Node** l = caminho[--h];
+            int antes = (*l)->height;
+            *l = balance(*l);
+            if ((*l)->height == antes) break;
+        }
+    }
+
+    // Remove uma cópia (se existir). Com mais de uma só desconta no caminho; senão tira o nó
+    // (com dois filhos ele fica com a chave do sucessor) e sobe rebalanceando tudo.
+    void remove(Key value) {
+        Node** caminho[ALTURA_MAX];
+        int h = 0;
+        Node** link = &root;
+        while (*link != nullptr && (comp(value, (*link)->key) || comp((*link)->key, value))) {
+            caminho[h++] = link;
+            link = comp(value, (*link)->key) ? &(*link)->left : &(*link)->right;
+        }
+        Node* alvo = *link;
+        if (alvo == nullptr) return;
+        if (alvo->count > 1) {
+            alvo->count--;
+            alvo->size--;
+            alvo->sum -= (double)value;
+            for (int i = 0; i < h; i++) {
+                (*caminho[i])->size--;
+                (*caminho[i])->sum -= (double)value;
+            }
+            return;
+        }
+        if (alvo->left != nullptr && alvo->right != nullptr) {
+            caminho[h++] = link;
+            Node** s = &alvo->right;
+            while ((*s)->left != nullptr) { caminho[h++] = s; s = &(*s)->left; }
+            Node* suc = *s;
+            alvo->key = suc->key;
+            alvo->count = suc->count;
+            *s = suc->right;
+            delete suc;
+        } else {
+            *link = (alvo->left != nullptr) ? alvo->left : alvo->right;
+            delete alvo;
+        }
+        nos--;
+        while (h > 0) {
+            Node** l = caminho[--h];
+            *l = balance(*l);
+        }
+    }
+
+    // Lote: ordena (se ainda não vier ordenado) e insere cada valor distinto uma vez só, com a quantidade
+    void insertBatch(std::span<const Key> batch) {
+        std::vector<Key> sorted(batch.begin(), batch.end());
+        if (!std::is_sorted(sorted.begin(), sorted.end(), comp)) std::sort(sorted.begin(), sorted.end(), comp);
+        for (size_t i = 0; i < sorted.size(); ) {
+            size_t j = i + 1;
+            while (j < sorted.size() && !comp(sorted[i], sorted[j])) j++;
+            insert(sorted[i], (int)(j - i));
+            i = j;
+        }
+    }
+
+    // Apaga tudo sem recursão: gira o filho esquerdo pra cima até virar uma lista pela direita
+    void clear() {
+        Node* n = root;
+        while (n != nullptr) {
+            if (n->left != nullptr) {
+                Node* l = n->left;
+                n->left = l->right;
+                l->right = n;
+                n = l;
+            } else {
+                Node* r = n->right;
+                delete n;
+                n = r;
+            }
+        }
+        root = nullptr;
+        nos = 0;
+    }
+
+    int count() { return size(root); }
+    bool isEmpty() { return root == nullptr; }
+
+    // Quantas chaves diferentes (= quantos nós)
+    size_t distinctCount() { return nos; }
+    size_t bytesUsed() { return nos * sizeof(Node); }
+
+    // Lista ordenada com as repetições
+    void getSortedList(std::vector<Key>& list) {
+        list.reserve(list.size() + size(root));
+        percorrer<true>([&](Node* n) { list.insert(list.end(), n->count, n->key); return true; });
+    }
+
+    // k-ésimo menor valor (k começa em 0): O(log D), D = chaves distintas
+    Key select(int k) {
+        Node* node = root;
+        while (node != nullptr) {
+            int l = size(node->left);
+            if (k < l) node = node->left;
+            else if (k < l + node->count) return node->key;
+            else { k -= l + node->count; node = node->right; }
+        }
+        return Key{};
+    }
+
+    // Quantos valores são menores que x
+    int rank(Key x) {
+        int r = 0;
+        Node* node = root;
+        while (node != nullptr) {
+            if (!comp(node->key, x)) node = node->left;
+            else { r += size(node->left) + node->count; node = node->right; }
+        }
+        return r;
+    }
+
+    double percentile(double p) {
+        int n = size(root);
+        if (n == 0) return 0.0;
+        double pos = std::clamp(p, 0.0, 100.0) / 100.0 * (n - 1);
+        int lo = (int)pos;
+        if (lo + 1 >= n) return select(n - 1);
+        double frac = pos - lo;
+        return select(lo) * (1.0 - frac) + select(lo + 1) * frac;
+    }
+
+    double median() {
+        int n = size(root);
+        if (n == 0) return 0.0;
+        if (n % 2 != 0) return select(n / 2);
+        else return ((double)select(n / 2 - 1) + select(n / 2)) / 2.0;
+    }
+
+    // Os n menores / maiores: o percurso para assim que juntou n
+    std::vector<Key> min(int n) {
+        std::vector<Key> res;
+        if (n <= 0) return res;
+        percorrer<true>([&](Node* no) {
+            res.insert(res.end(), std::min(no->count, n - (int)res.size()), no->key);
+            return (int)res.size() < n;
+        });
+        return res;
+    }
+
+    std::vector<Key> max(int n) {
+        std::vector<Key> res;
+        if (n <= 0) return res;
+        percorrer<false>([&](Node* no) {
+            res.insert(res.end(), std::min(no->count, n - (int)res.size()), no->key);
+            return (int)res.size() < n;
+        });
+        return res;
+    }
+
+    int rangeCount(Key x, Key y) {
+        int c; double s;
+        rangeAgg(x, y, c, s);
+        return c;
+    }
+
+    double rangeSum(Key x, Key y) {
+        int c; double s;
+        rangeAgg(x, y, c, s);
+        return s;
+    }
+
+    double rangeMean(Key x, Key y) {
+        int c; double s;
+        rangeAgg(x, y, c, s);
+        return (c == 0) ? std::numeric_limits<double>::quiet_NaN() : s / c;
+    }
+
+    double rangeMin(Key x, Key y) {
+        Node* best = nullptr;
+        for (Node* node = root; node != nullptr; ) {
+            if (!comp(node->key, x)) { best = node; node = node->left; }
+            else node = node->right;
+        }
+        return (best != nullptr && !comp(y, best->key)) ? (double)best->key : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    double rangeMax(Key x, Key y) {
+        Node* best = nullptr;
+        for (Node* node = root; node != nullptr; ) {
+            if (!comp(y, node->key)) { best = node; node = node->right; }
+            else node = node->left;
+        }
+        return (best != nullptr && !comp(best->key, x)) ? (double)best->key : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // visit(valor) em ordem crescente pra cada valor em [x, y] (repetidos uma vez por cópia).
+    // Desce até o primeiro >= x empilhando o caminho e segue pelo sucessor, sem recursão.
+    template <typename F>
+    size_t forEachInRange(Key x, Key y, F&& visit) {
+        size_t visitados = 0;
+        Node* pilha[ALTURA_MAX];
+        int h = 0;
+        for (Node* n = root; n != nullptr; ) {
+            if (comp(n->key, x)) n = n->right;
+            else { pilha[h++] = n; n = n->left; }
+        }
+        while (h > 0) {
+            Node* n = pilha[--h];
+            if (comp(y, n->key)) break;
+            for (int i = 0; i < n->count; i++) {
+                visitados++;
+                if (!visit(n->key)) return visitados;
+            }
+            for (Node* m = n->right; m != nullptr; m = m->left) pilha[h++] = m;
+        }
+        return visitados;
+    }
+
+    template <typename OutIt>
+    OutIt rangeQuery(Key x, Key y, OutIt out, size_t limit = std::numeric_limits<size_t>::max()) {
+        if (limit == 0) return out;
+        size_t n = 0;
+        forEachInRange(x, y, [&](Key v) { *out++ = v; return ++n < limit; });
+        return out;
+    }
+
+    std::vector<Key> rangeQuery(Key x, Key y) {
+        std::vector<Key> res;
+        res.reserve(rangeCount(x, y));
+        forEachInRange(x, y, [&](Key v) { res.push_back(v); return true; });
+        return res;
+    }
+};
+
+// Nó da AVL com pool: filhos são índices de 32 bits num vetor (24 bytes por nó com double)
+template <typename Key>
+struct PoolNode {
+    Key key;
+    uint32_t left, right;
+    int height;
+    int size;
+};
+
+// AVL com os nós num vetor contíguo (arena). Índice 0 é o "nulo" (altura e tamanho 0),
+// nós removidos vão pra uma lista livre e são reaproveitados, e clear() é O(1).
+template <typename Key = double, typename Compare = std::less<Key>>
+class PooledAVLTree {
+public:
+    using key_type = Key;
+    using key_compare = Compare;
+
+private:
+    static const uint32_t NIL = 0;
+    std::vector<PoolNode<Key>> nodes;
+    uint32_t root = NIL;
+    uint32_t freeHead = NIL; // lista livre encadeada pelo campo left
+    Compare comp;
+
+    int height(uint32_t n) { return nodes[n].height; }
+    int size(uint32_t n) { return nodes[n].size; }
+    int getBalance(uint32_t n) { return (n == NIL) ? 0 : height(nodes[n].left) - height(nodes[n].right); }
+
+    void update(uint32_t n) {
+        PoolNode<Key>& N = nodes[n];
+        N.height = std::max(height(N.left), height(N.right)) + 1;
+        N.size = size(N.left) + size(N.right) + 1;
+    }
+
+    // Pega um nó da lista livre ou aumenta o vetor
+    uint32_t newNode(Key key) {
+        uint32_t n;
+        if (freeHead != NIL) {
+            n = freeHead;
+            freeHead = nodes[n].left;
+        } else {
+            n = nodes.size();
+            nodes.push_back({});
+        }
+        nodes[n] = {key, NIL, NIL, 1, 1};
+        return n;
+    }
+
+    void freeNode(uint32_t n) {
+        nodes[n].left = freeHead;
+        freeHead = n;
+    }
+
+    uint32_t rightRotate(uint32_t y) {
+        uint32_t x = nodes[y].left;
+        nodes[y].left = nodes[x].right;
+        nodes[x].right = y;
+        update(y);
+        update(x);
+        return x;
+    }
+
+    uint32_t leftRotate(uint32_t x) {
+        uint32_t y = nodes[x].right;
+        nodes[x].right = nodes[y].left;
+        nodes[y].left = x;
+        update(x);
+        update(y);
+        return y;
+    }
+
+    // Rebalanceia o nó depois de inserir/remover em algum filho
+    uint32_t balance(uint32_t n) {
+        update(n);
+        int b = getBalance(n);
+        if (b > 1) {
+            if (getBalance(nodes[n].left) < 0) nodes[n].left = leftRotate(nodes[n].left);
+            return rightRotate(n);
+        }
+        if (b < -1) {
+            if (getBalance(nodes[n].right) > 0) nodes[n].right = rightRotate(nodes[n].right);
+            return leftRotate(n);
+        }
+        return n;
+    }
+
+    // Inserção recursiva (o vetor pode crescer, então não guarda referência pra nó)
+    uint32_t insertRec(uint32_t n, Key key) {
+        if (n == NIL) return newNode(key);
+        if (comp(key, nodes[n].key)) {
+            uint32_t l = insertRec(nodes[n].left, key);
+            nodes[n].left = l;
+        } else {
+            uint32_t r = insertRec(nodes[n].right, key);
+            nodes[n].right = r;
+        }
+        return balance(n);
+    }
+
+    uint32_t removeMin(uint32_t n, Key& key) {
+        if (nodes[n].left == NIL) {
+            key = nodes[n].key;
+            uint32_t r = nodes[n].right;
+            freeNode(n);
+            return r;
+        }
+        nodes[n].left = removeMin(nodes[n].left, key);
+        return balance(n);
+    }
+
+    uint32_t removeRec(uint32_t n, Key key) {
+        if (n == NIL) return NIL;
+        if (comp(key, nodes[n].key)) nodes[n].left = removeRec(nodes[n].left, key);
+        else if (comp(nodes[n].key, key)) nodes[n].right = removeRec(nodes[n].right, key);
+        else {
+            if (nodes[n].left == NIL || nodes[n].right == NIL) {
+                uint32_t child = (nodes[n].left != NIL) ? nodes[n].left : nodes[n].right;
+                freeNode(n);
+                return child;
+            }
+            Key succ;
+            nodes[n].right = removeMin(nodes[n].right, succ);
+            nodes[n].key = succ;
+        }
+        return balance(n);
+    }
+
+    void inorderToList(uint32_t n, std::vector<Key>& list) {
+        if (n == NIL) return;
+        inorderToList(nodes[n].left, list);
+        list.push_back(nodes[n].key);
+        inorderToList(nodes[n].right, list);
+    }
+
+    // Mesma borda da AVLTree::ponta, com índices
+    template <bool Crescente>
+    std::vector<Key> ponta(int n) {
+        std::vector<Key> res;
+        if (n <= 0) return res;
+        res.reserve(std::min(n, count()));
+        uint32_t pilha[64];
+        int h = 0;
+        for (uint32_t m = root; m != NIL; m = Crescente ? nodes[m].left : nodes[m].right) pilha[h++] = m;
+        while (h > 0 && (int)res.size() < n) {
+            uint32_t v = pilha[--h];
+            res.push_back(nodes[v].key);
+            for (uint32_t m = Crescente ? nodes[v].right : nodes[v].left; m != NIL; m = Crescente ? nodes[m].left : nodes[m].right) pilha[h++] = m;
+        }
+        return res;
+    }
+
+    void rangeQueryRec(uint32_t n, Key x, Key y, std::vector<Key>& res) {
+        if (n == NIL) return;
+        const PoolNode<Key>& N = nodes[n];
+        if (!comp(N.key, x)) rangeQueryRec(N.left, x, y, res);   // <= porque repetidos podem estar dos dois lados
+        if (dentroDoIntervalo(comp, N.key, x, y)) res.push_back(N.key);
+        if (!comp(y, N.key)) rangeQueryRec(N.right, x, y, res);
+    }
+
+public:
+    PooledAVLTree() { nodes.push_back({Key{}, NIL, NIL, 0, 0}); }
+
+    // Reserva espaço pra n leituras (evita realocar o vetor no meio)
+    void reserve(size_t n) { nodes.reserve(n + 1); }
+
+    void insert(Key value) { root = insertRec(root, value); }
+    void remove(Key value) { root = removeRec(root, value); }
+
+    // Apaga a árvore inteira de uma vez: O(1), não precisa visitar os nós
+    void clear() {
+        nodes.resize(1);
+        root = NIL;
+        freeHead = NIL;
+    }
+
+    int count() { return size(root); }
+    bool isEmpty() { return root == NIL; }
+
+    // Memória usada pelo pool (inclui nós livres e capacidade reservada)
+    size_t bytesUsed() { return nodes.capacity() * sizeof(PoolNode<Key>); }
+
+    Key select(int k) {
+        uint32_t n = root;
+        while (n != NIL) {
+            int l = size(nodes[n].left);
+            if (k < l) n = nodes[n].left;
+            else if (k == l) return nodes[n].key;
+            else { k -= l + 1; n = nodes[n].right; }
+        }
+        return Key{};
+    }
+
+    int rank(Key x) {
+        int r = 0;
+        uint32_t n = root;
+        while (n != NIL) {
+            if (!comp(nodes[n].key, x)) n = nodes[n].left;
+            else { r += size(nodes[n].left) + 1; n = nodes[n].right; }
+        }
+        return r;
+    }
+
+    double median() {
+        int n = size(root);
+        if (n == 0) return 0.0;
+        if (n % 2 != 0) return select(n / 2);
+        else return ((double)select(n / 2 - 1) + select(n / 2)) / 2.0;
+    }
+
+    void getSortedList(std::vector<Key>& list) { inorderToList(root, list); }
+
+    // Os n menores / maiores pela borda da árvore: O(log N + n)
+    std::vector<Key> min(int n) { return ponta<true>(n); }
+    std::vector<Key> max(int n) { return ponta<false>(n); }
+
+    std::vector<Key> rangeQuery(Key x, Key y) {
+        std::vector<Key> res;
+        rangeQueryRec(root, x, y, res);
+        return res;
+    }
+};
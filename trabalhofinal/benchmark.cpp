@@ -2,394 +2,386 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <fstream>
-#include <sstream>
-#include <chrono>
+#include <string>
+#include <map>
+#include <memory>
+#include <random>
 #include <iomanip>
+#include <sstream>
+#include <cmath>
+#include <array>
+#include <span>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "leituras_bin.hpp"
+#include "indices.hpp"
+#include "medicao.hpp"
+#include "gerador.hpp"
+
+// Uso: ./benchmark [opções]
+//   --max-n N        maior tamanho da varredura (1e3, 1e4, ... até N; padrão 1e8)
+//   --reps R         repetições medidas por operação (padrão 31)
+//   --aquecimento A  rodadas descartadas antes (padrão 3)
+//   --orcamento S    segundos por operação; passou disso, fica com as amostras que tem (padrão 1)
+//   --limite S       pula a operação se a previsão pra uma rodada passar de S segundos (padrão 30)
+//   --mem-mb M       memória máxima pra usar (padrão 60% da RAM)
+//   --float          usa float em vez de double nas estruturas
+//   --dist D         gera as leituras com o gerador.hpp (uniforme, passeio, ordenada, invertida,
+//                    repetidos, zipf, picos) em vez de usar o arquivo; cada N tem o próprio conjunto
+//   --seed S         semente do --dist (padrão 42)
+//   --csv arq        salva os resultados em CSV
+//   --json arq       salva os resultados em JSON
+struct OpcoesBenchmark {
+    ConfigMedicao cfg{3, 31, 1.0};
+    size_t maxN = 100000000;
+    double limiteSeg = 30.0;
+    double memMB = 0;
+    bool usarFloat = false;
+    bool usarGerador = false;
+    ConfigGerador gerador;
+    std::string csv, json;
+};
 
-// 1. Heap Minimo simples
-class PureMinHeap {
-private:
-    std::vector<double> heap;
-
-    int parent(int i) { return (i - 1) / 2; }
-    int leftChild(int i) { return (2 * i + 1); }
-    int rightChild(int i) { return (2 * i + 2); }
+// Memória física da máquina em MB (0 se não der pra saber)
+double memoriaFisicaMB() {
+#if defined(_SC_PHYS_PAGES) && defined(_SC_PAGE_SIZE)
+    return (double)sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGE_SIZE) / (1024.0 * 1024.0);
+#else
+    return 0;
+#endif
+}
 
-    // Sobe o elemento até ficar no lugar certo
-    void siftUp(int i) {
-        while (i > 0 && heap[parent(i)] > heap[i]) {
-            std::swap(heap[i], heap[parent(i)]);
-            i = parent(i);
-        }
-    }
+// Leituras pro teste: as do arquivo primeiro, depois sintéticas no mesmo formato
+// do gerardados (uniforme em [-10, 45], 2 casas), com semente fixa pra repetir igual
+std::vector<double> montarLeituras(const VisaoLeituras& arquivo, size_t n) {
+    std::vector<double> v;
+    v.reserve(n);
+    for (size_t i = 0; i < std::min(n, arquivo.size()); i++) v.push_back(arquivo[i]);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> dis(-10.0, 45.0);
+    while (v.size() < n) v.push_back(std::round(dis(gen) * 100.0) / 100.0);
+    return v;
+}
 
-    // Desce o elemento até ficar no lugar certo
-    void siftDown(int i) {
-        int minIndex = i;
-        int l = leftChild(i);
-        int r = rightChild(i);
-        int n = heap.size();
-        if (l < n && heap[l] < heap[minIndex]) minIndex = l;
-        if (r < n && heap[r] < heap[minIndex]) minIndex = r;
-        if (i != minIndex) {
-            std::swap(heap[i], heap[minIndex]);
-            siftDown(minIndex);
-        }
-    }
+// Guarda as últimas medianas de cada (estrutura, operação) pra prever o próximo N.
+// Cresce como N^k, com k tirado dos dois últimos pontos (com um ponto só, supõe k = 2).
+class PrevisaoTempo {
+private:
+    std::map<std::string, std::vector<std::pair<double, double>>> pontos; // (n, ns)
 
 public:
-    // Adiciona valor no heap
-    void insert(double value) {
-        heap.push_back(value);
-        siftUp(heap.size() - 1);
+    void registrar(const std::string& chave, double n, double ns) {
+        auto& p = pontos[chave];
+        p.push_back({n, std::max(ns, 1.0)});
+        if (p.size() > 2) p.erase(p.begin());
     }
 
-    // Remove valor do heap (se existir)
-    void remove(double value) {
-        int index = -1;
-        for (size_t i = 0; i < heap.size(); i++) {
-            if (heap[i] == value) { index = i; break; }
+    // Segundos previstos pra uma rodada com n leituras (0 se ainda não mediu)
+    double prever(const std::string& chave, double n) {
+        auto it = pontos.find(chave);
+        if (it == pontos.end()) return 0.0;
+        auto& p = it->second;
+        double k = 2.0;
+        if (p.size() == 2 && p[1].first > p[0].first) {
+            k = std::log(p[1].second / p[0].second) / std::log(p[1].first / p[0].first);
+            k = std::clamp(k, 1.0, 3.0);
         }
-        if (index == -1) return;
-        heap[index] = heap.back();
-        heap.pop_back();
-        if (index < heap.size()) {
-            siftDown(index);
-            siftUp(index);
-        }
-    }
-
-    // Calcula a mediana
-    double median() {
-        if (heap.empty()) return 0.0;
-        std::vector<double> temp = heap;
-        std::sort(temp.begin(), temp.end());
-        int n = temp.size();
-        if (n % 2 != 0) return temp[n / 2];
-        else return (temp[n / 2 - 1] + temp[n / 2]) / 2.0;
-    }
-
-    // Busca todos os valores no intervalo
-    std::vector<double> rangeQuery(double x, double y) {
-        std::vector<double> result;
-        for (double val : heap) {
-            if (val >= x && val <= y) result.push_back(val);
-        }
-        return result;
+        return p.back().second * std::pow(n / p.back().first, k) / 1e9;
     }
 };
 
-// 2. AVL Tree
-struct AVLNode {
-    double key;
-    AVLNode *left, *right;
-    int height;
-    AVLNode(double k) : key(k), left(nullptr), right(nullptr), height(1) {}
+struct ContextoBenchmark {
+    OpcoesBenchmark op;
+    PrevisaoTempo previsao;
+    std::vector<ResultadoMedicao> resultados;
+    std::vector<std::string> avisos;
+    std::map<std::pair<std::string, size_t>, size_t> memoria; // (estrutura, n) -> bytes
 };
 
-class AVLTree {
-private:
-    AVLNode* root;
-
-    int height(AVLNode* N) { return (N == nullptr) ? 0 : N->height; }
-    int getBalance(AVLNode* N) { return (N == nullptr) ? 0 : height(N->left) - height(N->right); }
-
-    AVLNode* rightRotate(AVLNode* y) {
-        AVLNode* x = y->left;
-        AVLNode* T2 = x->right;
-        x->right = y; y->left = T2;
-        y->height = std::max(height(y->left), height(y->right)) + 1;
-        x->height = std::max(height(x->left), height(x->right)) + 1;
-        return x;
-    }
-
-    AVLNode* leftRotate(AVLNode* x) {
-        AVLNode* y = x->right;
-        AVLNode* T2 = y->left;
-        y->left = x; x->right = T2;
-        x->height = std::max(height(x->left), height(x->right)) + 1;
-        y->height = std::max(height(y->left), height(y->right)) + 1;
-        return y;
-    }
-
-    AVLNode* insertRec(AVLNode* node, double key) {
-        if (node == nullptr) return new AVLNode(key);
-        if (key < node->key) node->left = insertRec(node->left, key);
-        else node->right = insertRec(node->right, key);
-
-        node->height = 1 + std::max(height(node->left), height(node->right));
-        int balance = getBalance(node);
-
-        if (balance > 1 && key < node->left->key) return rightRotate(node);
-        if (balance < -1 && key >= node->right->key) return leftRotate(node);
-        if (balance > 1 && key >= node->left->key) {
-            node->left = leftRotate(node->left); return rightRotate(node);
-        }
-        if (balance < -1 && key < node->right->key) {
-            node->right = rightRotate(node->right); return leftRotate(node);
-        }
-        return node;
-    }
-
-    AVLNode* minValueNode(AVLNode* node) {
-        AVLNode* current = node;
-        while (current->left != nullptr) current = current->left;
-        return current;
-    }
+// Mostra ns na unidade que fica mais legível
+std::string formatarTempo(double ns) {
+    std::ostringstream s;
+    s << std::fixed << std::setprecision(ns < 10 ? 1 : 0);
+    if (ns < 1e3) s << ns << "ns";
+    else if (ns < 1e6) s << std::setprecision(1) << ns / 1e3 << "us";
+    else if (ns < 1e9) s << std::setprecision(1) << ns / 1e6 << "ms";
+    else s << std::setprecision(2) << ns / 1e9 << "s";
+    return s.str();
+}
 
-    AVLNode* removeRec(AVLNode* root, double key) {
-        if (root == nullptr) return root;
-        if (key < root->key) root->left = removeRec(root->left, key);
-        else if (key > root->key) root->right = removeRec(root->right, key);
-        else {
-            if ((root->left == nullptr) || (root->right == nullptr)) {
-                AVLNode* temp = root->left ? root->left : root->right;
-                if (!temp) { temp = root; root = nullptr; }
-                else *root = *temp;
-                delete temp;
-            } else {
-                AVLNode* temp = minValueNode(root->right);
-                root->key = temp->key;
-                root->right = removeRec(root->right, temp->key);
+// Roda todas as operações numa estrutura com as leituras dados[0, n).
+// criar() devolve uma estrutura nova e vazia.
+template <typename Idx, typename Criar>
+void medirEstrutura(ContextoBenchmark& ctx, const std::string& nome, Criar criar,
+                    std::span<const typename Idx::key_type> dados) {
+    using Key = typename Idx::key_type;
+    const size_t n = dados.size();
+    const Key lo = (Key)20.0, hi = (Key)30.0;
+    std::unique_ptr<Idx> idx;
+    std::mt19937 gen(7);
+
+    auto registrar = [&](const std::string& op, const std::vector<double>& amostras) {
+        Estatisticas e = resumir(amostras);
+        ctx.previsao.registrar(nome + "|" + op, n, e.mediana);
+        ctx.resultados.push_back({nome, op, n, e});
+    };
+    // Pula se a previsão de alguma das operações passar do limite
+    auto cabe = [&](std::initializer_list<const char*> ops) {
+        for (const char* op : ops) {
+            double s = ctx.previsao.prever(nome + "|" + op, n);
+            if (s > ctx.op.limiteSeg) {
+                ctx.avisos.push_back(nome + " " + op + " com N=" + std::to_string(n) + " pulado (previsto "
+                                     + formatarTempo(s * 1e9) + " por rodada)");
+                return false;
             }
         }
-        if (root == nullptr) return root;
-        root->height = 1 + std::max(height(root->left), height(root->right));
-        int balance = getBalance(root);
-        if (balance > 1 && getBalance(root->left) >= 0) return rightRotate(root);
-        if (balance > 1 && getBalance(root->left) < 0) { root->left = leftRotate(root->left); return rightRotate(root); }
-        if (balance < -1 && getBalance(root->right) <= 0) return leftRotate(root);
-        if (balance < -1 && getBalance(root->right) > 0) { root->right = rightRotate(root->right); return leftRotate(root); }
-        return root;
-    }
+        return true;
+    };
+    // Mede uma operação que devolve o tempo (ns) da rodada
+    auto medir = [&](const char* op, auto&& rodada) {
+        if (!cabe({op})) return;
+        std::vector<double> amostras;
+        repetir(ctx.op.cfg, [&](bool valendo) {
+            double t = rodada();
+            if (valendo) amostras.push_back(t);
+        });
+        registrar(op, amostras);
+    };
 
-    void inorderToList(AVLNode* root, std::vector<double>& list) {
-        if (root != nullptr) {
-            inorderToList(root->left, list);
-            list.push_back(root->key);
-            inorderToList(root->right, list);
-        }
+    // Insert das N leituras numa estrutura nova + a primeira mediana logo depois
+    // (pro vetor é aí que acontece o Insertion Sort inteiro)
+    if (!cabe({"insert", "mediana fria"})) return;
+    std::vector<double> tIns, tFria;
+    repetir(ctx.op.cfg, [&](bool valendo) {
+        idx.reset();
+        idx = criar(); // a destruição da anterior fica fora da medida
+        double a = cronometrar([&] { for (Key v : dados) idx->insert(v); });
+        double med;
+        double b = cronometrar([&] { med = idx->median(); });
+        naoOtimizar(med);
+        if (valendo) { tIns.push_back(a); tFria.push_back(b); }
+    });
+    registrar("insert", tIns);
+    registrar("mediana fria", tFria);
+
+    // Carga em lote, só pra quem tem (AVL: bulkLoad, heap: buildFrom)
+    if constexpr (requires(Idx& i) { i.bulkLoad(dados); }) {
+        medir("bulkLoad", [&] {
+            auto outra = criar();
+            double t = cronometrar([&] { outra->bulkLoad(dados); });
+            naoOtimizar(outra->count());
+            return t;
+        });
+    } else if constexpr (requires(Idx& i) { i.buildFrom(dados); }) {
+        medir("bulkLoad", [&] {
+            auto outra = criar();
+            double t = cronometrar([&] { outra->buildFrom(dados); });
+            naoOtimizar(outra->count());
+            return t;
+        });
     }
 
-    void rangeQueryRec(AVLNode* node, double x, double y, std::vector<double>& res) {
-        if (node == nullptr) return;
-        if (x < node->key) rangeQueryRec(node->left, x, y, res);
-        if (node->key >= x && node->key <= y) res.push_back(node->key);
-        if (y > node->key) rangeQueryRec(node->right, x, y, res);
-    }
+    // Mediana depois de chegar uma leitura nova (a leitura sai de novo fora da medida)
+    medir("mediana", [&] {
+        Key v = dados[gen() % n];
+        idx->insert(v);
+        double med;
+        double t = cronometrar([&] { med = idx->median(); });
+        naoOtimizar(med);
+        idx->remove(v);
+        return t;
+    });
+
+    medir("range", [&] {
+        std::vector<Key> r;
+        double t = cronometrar([&] { r = idx->rangeQuery(lo, hi); });
+        naoOtimizar(r.data());
+        return t;
+    });
+
+    medir("range 100", [&] {
+        std::array<Key, 100> buffer;
+        double t = cronometrar([&] { idx->rangeQuery(lo, hi, buffer.begin(), buffer.size()); });
+        naoOtimizar(buffer);
+        return t;
+    });
+
+    // Os 10 maiores logo depois de chegar uma leitura (o "top 10 mais quentes" do painel)
+    medir("max 10", [&] {
+        Key v = dados[gen() % n];
+        idx->insert(v);
+        std::vector<Key> top;
+        double t = cronometrar([&] { top = idx->max(10); });
+        naoOtimizar(top.data());
+        idx->remove(v);
+        return t;
+    });
+
+    // Remove uma leitura que existe (volta pra estrutura fora da medida)
+    medir("remove", [&] {
+        Key v = dados[gen() % n];
+        double t = cronometrar([&] { idx->remove(v); });
+        idx->insert(v);
+        return t;
+    });
+
+    if constexpr (requires(Idx& i) { i.bytesUsed(); }) ctx.memoria[{nome, n}] = idx->bytesUsed();
+}
 
-public:
-    AVLTree() : root(nullptr) {}
-    void insert(double value) { root = insertRec(root, value); }
-    void remove(double value) { root = removeRec(root, value); }
-
-    double median() {
-        std::vector<double> list;
-        inorderToList(root, list);
-        if (list.empty()) return 0.0;
-        int n = list.size();
-        if (n % 2 != 0) return list[n / 2];
-        return (list[n / 2 - 1] + list[n / 2]) / 2.0;
-    }
+// Uma estrutura da tabela: nome, como criar e quantos bytes por leitura ela gasta (estimativa pro limite de memória)
+template <typename Key>
+void medirTamanho(ContextoBenchmark& ctx, std::span<const Key> dados) {
+    size_t n = dados.size();
+    double livreMB = ctx.op.memMB;
+    // Sempre sobra espaço pro resultado do range (até N chaves)
+    auto cabeNaMemoria = [&](const std::string& nome, double bytesPorLeitura) {
+        double mb = (bytesPorLeitura + sizeof(Key)) * n / (1024.0 * 1024.0);
+        if (mb <= livreMB) return true;
+        ctx.avisos.push_back(nome + " com N=" + std::to_string(n) + " pulado (precisa de ~"
+                             + std::to_string((long)mb) + " MB)");
+        return false;
+    };
 
-    std::vector<double> rangeQuery(double x, double y) {
-        std::vector<double> res;
-        rangeQueryRec(root, x, y, res);
-        return res;
-    }
-};
+    if (cabeNaMemoria("HEAP", 2 * sizeof(Key)))
+        medirEstrutura<PureMinHeap<Key>>(ctx, "HEAP", [] { return std::make_unique<PureMinHeap<Key>>(); }, dados);
+    if (cabeNaMemoria("HEAP(live)", 6 * sizeof(Key) + 32))
+        medirEstrutura<PureMinHeap<Key>>(ctx, "HEAP(live)", [] { return std::make_unique<PureMinHeap<Key>>(true); }, dados);
+    if (cabeNaMemoria("AVL", sizeof(AVLNode<Key>) + 16))
+        medirEstrutura<AVLTree<Key>>(ctx, "AVL", [] { return std::make_unique<AVLTree<Key>>(); }, dados);
+    if (cabeNaMemoria("AVL(cont)", sizeof(CountedAVLNode<Key>) + 16))
+        medirEstrutura<CountedAVLTree<Key>>(ctx, "AVL(cont)", [] { return std::make_unique<CountedAVLTree<Key>>(); }, dados);
+    if (cabeNaMemoria("VEC(Ins)", 2 * sizeof(Key)))
+        medirEstrutura<VectorInsertionSort<Key>>(ctx, "VEC(Ins)", [] { return std::make_unique<VectorInsertionSort<Key>>(); }, dados);
+    if (cabeNaMemoria("VEC(adapt)", 3 * sizeof(Key)))
+        medirEstrutura<VectorInsertionSort<Key>>(ctx, "VEC(adapt)", [] { return std::make_unique<VectorInsertionSort<Key>>(true); }, dados);
+    if (cabeNaMemoria("HIST", 0))
+        medirEstrutura<FenwickHistogram<Key>>(ctx, "HIST", [] { return std::make_unique<FenwickHistogram<Key>>(); }, dados);
+}
 
-// 3. Vector + Insertion Sort
-class VectorInsertionSort {
-private:
-    std::vector<double> data;
-    bool sorted = false;
-
-    // Insertion Sort (bem lento pra muitos dados)
-    void runInsertionSort() {
-        int n = data.size();
-        for (int i = 1; i < n; i++) {
-            double key = data[i];
-            int j = i - 1;
-            while (j >= 0 && data[j] > key) {
-                data[j + 1] = data[j];
-                j = j - 1;
-            }
-            data[j + 1] = key;
+// Tabela de um N: mediana de cada estrutura e o vencedor.
+// Se o p95 do mais rápido passa da mediana do segundo, os dois ficam empatados ("A ~ B").
+void imprimirTabela(const ContextoBenchmark& ctx, size_t n) {
+    const std::vector<std::string> estruturas = {"HEAP", "HEAP(live)", "AVL", "AVL(cont)", "VEC(Ins)", "VEC(adapt)", "HIST"};
+    const std::vector<std::string> ops = {"insert", "mediana fria", "bulkLoad", "mediana", "range", "range 100", "max 10", "remove"};
+
+    std::cout << "\n=== N = " << n << " (mediana das rodadas) ===\n";
+    std::cout << std::left << std::setw(14) << "Operacao";
+    for (const std::string& e : estruturas) std::cout << std::setw(12) << e;
+    std::cout << "Vencedor\n";
+    std::cout << std::string(14 + 12 * estruturas.size() + 12, '-') << "\n";
+
+    for (const std::string& op : ops) {
+        std::vector<const ResultadoMedicao*> linha;
+        for (const std::string& e : estruturas) {
+            const ResultadoMedicao* achado = nullptr;
+            for (const ResultadoMedicao& r : ctx.resultados)
+                if (r.n == n && r.operacao == op && r.estrutura == e) achado = &r;
+            linha.push_back(achado);
         }
-        sorted = true;
-    }
+        if (std::none_of(linha.begin(), linha.end(), [](auto* r) { return r != nullptr; })) continue;
 
-public:
-    // Adiciona valor (super rápido)
-    void insert(double value) {
-        data.push_back(value);
-        sorted = false;
-    }
-
-    // Remove valor (O(N))
-    void remove(double value) {
-        for (auto it = data.begin(); it != data.end(); ++it) {
-            if (*it == value) {
-                data.erase(it);
-                return;
-            }
+        std::cout << std::setw(14) << op;
+        std::vector<const ResultadoMedicao*> ordem;
+        for (const ResultadoMedicao* r : linha) {
+            std::cout << std::setw(12) << (r ? formatarTempo(r->ns.mediana) : "-");
+            if (r) ordem.push_back(r);
         }
+        std::sort(ordem.begin(), ordem.end(), [](auto* a, auto* b) { return a->ns.mediana < b->ns.mediana; });
+        std::string vencedor = ordem[0]->estrutura;
+        if (ordem.size() > 1 && ordem[0]->ns.p95 >= ordem[1]->ns.mediana) vencedor += " ~ " + ordem[1]->estrutura;
+        std::cout << vencedor << "\n";
     }
 
-    // Mediana (fica lento se não estiver ordenado)
-    double median() {
-        if (data.empty()) return 0.0;
-        if (!sorted) runInsertionSort();
-
-        int n = data.size();
-        if (n % 2 != 0) return data[n / 2];
-        else return (data[n / 2 - 1] + data[n / 2]) / 2.0;
+    std::cout << std::setw(14) << "memoria";
+    for (const std::string& e : estruturas) {
+        auto it = ctx.memoria.find({e, n});
+        std::cout << std::setw(12) << (it != ctx.memoria.end() ? std::to_string(it->second / 1024) + " KB" : "-");
     }
+    std::cout << "\n";
+}
 
-    // Busca todos os valores no intervalo
-    std::vector<double> rangeQuery(double x, double y) {
-        std::vector<double> result;
-        for (double val : data) {
-            if (val >= x && val <= y) result.push_back(val);
+int main(int argc, char* argv[]) {
+    ContextoBenchmark ctx;
+    OpcoesBenchmark& op = ctx.op;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--max-n" && temValor) op.maxN = (size_t)std::stod(argv[++i]);
+        else if (arg == "--reps" && temValor) op.cfg.repeticoes = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--aquecimento" && temValor) op.cfg.aquecimento = std::max(0, std::stoi(argv[++i]));
+        else if (arg == "--orcamento" && temValor) op.cfg.orcamentoSeg = std::stod(argv[++i]);
+        else if (arg == "--limite" && temValor) op.limiteSeg = std::stod(argv[++i]);
+        else if (arg == "--mem-mb" && temValor) op.memMB = std::stod(argv[++i]);
+        else if (arg == "--float") op.usarFloat = true;
+        else if (arg == "--seed" && temValor) op.gerador.semente = std::stoull(argv[++i]);
+        else if (arg == "--dist" && temValor) {
+            op.usarGerador = true;
+            if (!distribuicaoPorNome(argv[++i], op.gerador.dist)) {
+                std::cerr << "Distribuicao desconhecida: " << argv[i] << " (use " << nomesDistribuicoes() << ")" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--csv" && temValor) op.csv = argv[++i];
+        else if (arg == "--json" && temValor) op.json = argv[++i];
+        else {
+            std::cerr << "Opcao invalida: " << arg << std::endl;
+            std::cerr << "Uso: ./benchmark [--max-n N] [--reps R] [--aquecimento A] [--orcamento S] [--limite S]"
+                      << " [--mem-mb M] [--float] [--dist D] [--seed S] [--csv arq] [--json arq]" << std::endl;
+            return 1;
         }
-        return result;
     }
-};
-
-// Função pra ler o CSV
-std::vector<double> lerCSV(const std::string& arquivo) {
-    std::vector<double> dados;
-    std::ifstream file(arquivo);
-    std::string linha;
-    if (!file.is_open()) {
-        std::cerr << "Erro ao abrir arquivo!" << std::endl;
-        return dados;
+    if (op.memMB <= 0) op.memMB = memoriaFisicaMB() > 0 ? 0.6 * memoriaFisicaMB() : 4096;
+    op.maxN = std::max<size_t>(op.maxN, 1000);
+
+    // Começa com as leituras de temperaturas.bin/.csv e completa com sintéticas até maxN,
+    // ou (com --dist) gera tudo com o gerador, de novo pra cada N
+    Dataset ds;
+    if (op.usarGerador) {
+        for (const InfoDistribuicao& info : DISTRIBUICOES) {
+            if (info.tipo == op.gerador.dist) std::cout << "Leituras geradas: " << info.nome;
+        }
+        std::cout << " (semente " << op.gerador.semente << ")\n";
+    } else {
+        ds = carregarLeituras("temperaturas");
+        std::cout << "Leituras do arquivo: " << ds.valores.size() << " ("
+                  << (ds.binario ? "temperaturas.bin" : "temperaturas.csv") << "), resto sintético (mt19937, semente 42)\n";
     }
-    while (std::getline(file, linha)) {
-        if (!linha.empty()) {
-            try { dados.push_back(std::stod(linha)); } catch (...) {}
+    std::cout << "Chave: " << (op.usarFloat ? "float" : "double") << " | repeticoes: " << op.cfg.repeticoes
+              << " | aquecimento: " << op.cfg.aquecimento << " | orcamento: " << op.cfg.orcamentoSeg
+              << " s/op | limite: " << op.limiteSeg << " s/rodada | memoria: " << (long)op.memMB << " MB\n";
+    std::cout << "Custo do relogio descontado: " << formatarTempo(custoRelogioNs()) << std::endl;
+
+    // As leituras base contam na memória
+    std::vector<double> base;
+    if (!op.usarGerador) base = montarLeituras(ds.valores, op.maxN);
+    op.memMB -= op.maxN * sizeof(double) * (op.usarFloat ? 1.5 : 1.0) / (1024.0 * 1024.0);
+
+    std::vector<float> baseFloat;
+    if (op.usarFloat && !op.usarGerador) baseFloat.assign(base.begin(), base.end());
+
+    for (size_t n = 1000; n <= op.maxN; n *= 10) {
+        if (op.usarGerador) {
+            // Ordenada/invertida/passeio dependem de N: um prefixo do conjunto maior não serve
+            ConfigGerador cfg = op.gerador;
+            cfg.n = n;
+            base = gerarLeituras(cfg);
+            if (op.usarFloat) baseFloat.assign(base.begin(), base.end());
         }
+        if (op.usarFloat) medirTamanho<float>(ctx, std::span<const float>(baseFloat.data(), n));
+        else medirTamanho<double>(ctx, std::span<const double>(base.data(), n));
+        imprimirTabela(ctx, n);
     }
-    return dados;
-}
 
-int main() {
-    std::vector<double> dataset = lerCSV("temperaturas.csv");
-    if (dataset.empty()) {
-        std::cout << "Gere o CSV primeiro!" << std::endl;
-        return 1;
+    if (!ctx.avisos.empty()) {
+        std::cout << "\nObservacoes:\n";
+        for (const std::string& a : ctx.avisos) std::cout << "- " << a << "\n";
     }
 
-    std::cout << "Dados carregados: " << dataset.size() << " entradas." << std::endl;
-    std::cout << std::fixed << std::setprecision(2);
-
-    PureMinHeap heap;
-    AVLTree avl;
-    VectorInsertionSort vec;
-
-    using namespace std::chrono;
-
-    // Teste 1: Inserção
-    auto start = high_resolution_clock::now();
-    for (double val : dataset) heap.insert(val);
-    auto end = high_resolution_clock::now();
-    auto tHeapIns = duration_cast<microseconds>(end - start).count();
-
-    start = high_resolution_clock::now();
-    for (double val : dataset) avl.insert(val);
-    end = high_resolution_clock::now();
-    auto tAvlIns = duration_cast<microseconds>(end - start).count();
-
-    start = high_resolution_clock::now();
-    for (double val : dataset) vec.insert(val);
-    end = high_resolution_clock::now();
-    auto tVecIns = duration_cast<microseconds>(end - start).count();
-
-    // Teste 2: Mediana
-    start = high_resolution_clock::now();
-    heap.median();
-    end = high_resolution_clock::now();
-    auto tHeapMed = duration_cast<microseconds>(end - start).count();
-
-    start = high_resolution_clock::now();
-    avl.median();
-    end = high_resolution_clock::now();
-    auto tAvlMed = duration_cast<microseconds>(end - start).count();
-
-    start = high_resolution_clock::now();
-    vec.median();
-    end = high_resolution_clock::now();
-    auto tVecMed = duration_cast<microseconds>(end - start).count();
-
-    // Teste 3: Range Query
-    start = high_resolution_clock::now();
-    heap.rangeQuery(20.0, 30.0);
-    end = high_resolution_clock::now();
-    auto tHeapRng = duration_cast<microseconds>(end - start).count();
-
-    start = high_resolution_clock::now();
-    avl.rangeQuery(20.0, 30.0);
-    end = high_resolution_clock::now();
-    auto tAvlRng = duration_cast<microseconds>(end - start).count();
-
-    start = high_resolution_clock::now();
-    vec.rangeQuery(20.0, 30.0);
-    end = high_resolution_clock::now();
-    auto tVecRng = duration_cast<microseconds>(end - start).count();
-
-    // Teste 4: Remoção (100 itens)
-    std::vector<double> toRemove;
-    for(int i=0; i<100; i++) toRemove.push_back(dataset[i]);
-
-    start = high_resolution_clock::now();
-    for (double val : toRemove) heap.remove(val);
-    end = high_resolution_clock::now();
-    auto tHeapRem = duration_cast<microseconds>(end - start).count();
-
-    start = high_resolution_clock::now();
-    for (double val : toRemove) avl.remove(val);
-    end = high_resolution_clock::now();
-    auto tAvlRem = duration_cast<microseconds>(end - start).count();
-
-    start = high_resolution_clock::now();
-    for (double val : toRemove) vec.remove(val);
-    end = high_resolution_clock::now();
-    auto tVecRem = duration_cast<microseconds>(end - start).count();
-
-    // Resultados
-    std::cout << "\n=== RESULTADOS DO BENCHMARK (Microsegundos - us) ===\n";
-    std::cout << std::left << std::setw(15) << "Operacao" 
-            << std::setw(12) << "HEAP" 
-            << std::setw(12) << "AVL" 
-            << std::setw(12) << "VEC(Ins)" 
-            << "Vencedor" << std::endl;
-    std::cout << "------------------------------------------------------------\n";
-    
-    // Função pra imprimir linha da tabela
-    auto printRow = [](std::string op, long tH, long tA, long tV) {
-        std::string winner;
-        if (tH <= tA && tH <= tV) winner = "HEAP";
-        else if (tA <= tH && tA <= tV) winner = "AVL";
-        else winner = "VEC";
-
-        std::cout << std::left << std::setw(15) << op 
-                << std::setw(12) << tH 
-                << std::setw(12) << tA 
-                << std::setw(12) << tV 
-                << winner << std::endl;
-    };
-
-    printRow("Insert (1000x)", tHeapIns, tAvlIns, tVecIns);
-    printRow("Median Calc", tHeapMed, tAvlMed, tVecMed);
-    printRow("Range Query", tHeapRng, tAvlRng, tVecRng);
-    printRow("Remove (100x)", tHeapRem, tAvlRem, tVecRem);
-
-    std::cout << "\nResumo rápido: \n";
-    std::cout << "- Vector (Ins) ganha na inserção porque só adiciona no fim (O(1)).\n";
-    std::cout << "- Vector é muito ruim pra mediana porque faz Insertion Sort O(N^2).\n";
-    std::cout << "- AVL é muito boa pra range e remoção.\n";
+    if (!op.csv.empty() && salvarCSV(op.csv, ctx.resultados)) std::cout << "CSV salvo em " << op.csv << std::endl;
+    if (!op.json.empty() && salvarJSON(op.json, ctx.resultados)) std::cout << "JSON salvo em " << op.json << std::endl;
 
     return 0;
-}
\ No newline at end of file
+}
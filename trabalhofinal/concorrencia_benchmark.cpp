@@ -0,0 +1,169 @@
+// Bibliotecas que vou usar
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <shared_mutex>
+#include <random>
+#include <iomanip>
+#include <sstream>
+#include <cmath>
+#include <span>
+#include <type_traits>
+
+#include "indices.hpp"
+#include "medicao.hpp"
+
+// Uso: ./concorrencia [opções]
+//   --max-threads T   varre 1, 2, 4, ... até T threads (padrão 64)
+//   --ops N           operações por rodada, divididas entre as threads (padrão 400000): o
+//                     trabalho total é o mesmo em toda linha, então Mops/s compara direto
+//   --pct-range P     % das operações que são rangeQuery (o resto é insert; padrão 10)
+//   --largura L       largura do intervalo de cada rangeQuery em graus (padrão 0.05)
+//   --inicial N       leituras já na árvore antes de começar (padrão 100000)
+//   --reps R          rodadas por configuração; mostra a mediana (padrão 3)
+//
+// Compara três jeitos de deixar várias threads mexerem na mesma AVL:
+//   AVL+mutex         o que o gateway faz hoje: um mutex em volta de tudo
+//   AVL+rwlock        um shared_mutex: leitores juntos, escritor sozinho
+//   Concorrente       ConcurrentAVLTree (uma trava por fatia de temperatura)
+
+struct OpcoesConcorrencia {
+    int maxThreads = 64;
+    int ops = 400000;
+    int pctRange = 10;
+    double largura = 0.05;
+    int inicial = 100000;
+    int reps = 3;
+};
+
+// Uma AVL só com um mutex em volta de tudo
+class AVLComMutex {
+    AVLTree<> arvore;
+    std::mutex trava;
+public:
+    void insert(double v) { std::lock_guard lock(trava); arvore.insert(v); }
+    std::vector<double> rangeQuery(double x, double y) { std::lock_guard lock(trava); return arvore.rangeQuery(x, y); }
+    void insertBatch(std::span<const double> lote) { std::lock_guard lock(trava); arvore.bulkLoad(lote); }
+};
+
+// Uma AVL só com um shared_mutex (consultas em paralelo entre si)
+class AVLComRWLock {
+    AVLTree<> arvore;
+    std::shared_mutex trava;
+public:
+    void insert(double v) { std::unique_lock lock(trava); arvore.insert(v); }
+    std::vector<double> rangeQuery(double x, double y) { std::shared_lock lock(trava); return arvore.rangeQuery(x, y); }
+    void insertBatch(std::span<const double> lote) { std::unique_lock lock(trava); arvore.bulkLoad(lote); }
+};
+
+// Valores como o gerardados: uniforme em [-10, 45] com 2 casas
+double sortear(std::mt19937& gen) {
+    std::uniform_real_distribution<> dis(-10.0, 45.0);
+    return std::round(dis(gen) * 100.0) / 100.0;
+}
+
+// Roda T threads com a carga mista numa estrutura nova e devolve milhões de operações por segundo
+template <typename Estrutura>
+double rodada(const OpcoesConcorrencia& op, int T, const std::vector<double>& inicial) {
+    // A ConcurrentAVLTree tira os limites das fatias das leituras iniciais
+    auto criar = [&] {
+        if constexpr (std::is_constructible_v<Estrutura, std::span<const double>>)
+            return Estrutura(std::span<const double>(inicial));
+        else
+            return Estrutura();
+    };
+    Estrutura e = criar();
+    e.insertBatch(inicial);
+
+    std::atomic<int> prontas{0};
+    std::atomic<bool> largar{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < T; t++) {
+        int minhas = op.ops / T + (t < op.ops % T);
+        threads.emplace_back([&, t, minhas] {
+            std::mt19937 gen(1000 + t);
+            std::uniform_int_distribution<int> pct(0, 99);
+            // sorteia tudo antes pra não medir o gerador
+            std::vector<double> valores(minhas);
+            std::vector<char> ehRange(minhas);
+            for (int i = 0; i < minhas; i++) {
+                valores[i] = sortear(gen);
+                ehRange[i] = pct(gen) < op.pctRange;
+            }
+            prontas++;
+            while (!largar.load(std::memory_order_acquire)) std::this_thread::yield();
+            size_t achados = 0;
+            for (int i = 0; i < minhas; i++) {
+                if (ehRange[i]) achados += e.rangeQuery(valores[i], valores[i] + op.largura).size();
+                else e.insert(valores[i]);
+            }
+            naoOtimizar(achados);
+        });
+    }
+    while (prontas.load() < T) std::this_thread::yield();
+    double ns = cronometrar([&] {
+        largar.store(true, std::memory_order_release);
+        for (auto& th : threads) th.join();
+    });
+    return (double)op.ops / ns * 1000.0; // ops/ns -> Mops/s
+}
+
+std::string textoMops(double mops) {
+    std::ostringstream s;
+    s << std::fixed << std::setprecision(3) << mops << " Mops/s";
+    return s.str();
+}
+
+template <typename Estrutura>
+double medianaRodadas(const OpcoesConcorrencia& op, int T, const std::vector<double>& inicial) {
+    std::vector<double> r;
+    for (int i = 0; i < op.reps; i++) r.push_back(rodada<Estrutura>(op, T, inicial));
+    return resumir(r).mediana;
+}
+
+int main(int argc, char* argv[]) {
+    OpcoesConcorrencia op;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--max-threads" && temValor) op.maxThreads = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--ops" && temValor) op.ops = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--pct-range" && temValor) op.pctRange = std::clamp(std::stoi(argv[++i]), 0, 100);
+        else if (arg == "--largura" && temValor) op.largura = std::stod(argv[++i]);
+        else if (arg == "--inicial" && temValor) op.inicial = std::max(0, std::stoi(argv[++i]));
+        else if (arg == "--reps" && temValor) op.reps = std::max(1, std::stoi(argv[++i]));
+        else {
+            std::cerr << "Uso: ./concorrencia [--max-threads T] [--ops N] [--pct-range P] [--largura L]"
+                      << " [--inicial N] [--reps R]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::mt19937 gen(42);
+    std::vector<double> inicial(op.inicial);
+    for (double& v : inicial) v = sortear(gen);
+
+    unsigned nucleos = std::thread::hardware_concurrency();
+    std::cout << "Carga: " << 100 - op.pctRange << "% insert / " << op.pctRange << "% rangeQuery (largura "
+              << op.largura << "), " << op.ops << " ops divididas entre as threads, " << op.inicial << " leituras iniciais\n";
+    std::cout << "Nucleos na maquina: " << nucleos
+              << " (acima disso as threads só disputam a CPU; o ganho que sobra é de não esperar trava)\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(9) << "Threads" << std::setw(15) << "AVL+mutex" << std::setw(15) << "AVL+rwlock"
+              << std::setw(15) << "Concorrente" << "Ganho vs mutex" << std::endl;
+    std::cout << std::string(66, '-') << std::endl;
+
+    for (int T = 1; T <= op.maxThreads; T *= 2) {
+        double mutex = medianaRodadas<AVLComMutex>(op, T, inicial);
+        double rw = medianaRodadas<AVLComRWLock>(op, T, inicial);
+        double conc = medianaRodadas<ConcurrentAVLTree<>>(op, T, inicial);
+        std::cout << std::setw(9) << T << std::setw(15) << textoMops(mutex) << std::setw(15) << textoMops(rw)
+                  << std::setw(15) << textoMops(conc) << conc / mutex << "x" << std::endl;
+    }
+
+    return 0;
+}
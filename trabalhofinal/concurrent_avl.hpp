@@ -0,0 +1,309 @@
+// AVL pra várias threads inserindo ao mesmo tempo (um gateway com uma thread por segmento)
+//
+// A faixa de chaves é dividida em fatias, cada uma com a própria AVLTree e o próprio
+// std::shared_mutex. Os limites das fatias saem dos quantis de uma amostra dos dados
+// (cada fatia recebe mais ou menos a mesma parte das escritas, mesmo com os valores
+// concentrados) ou são passados direto, na unidade da chave (°C pra double/float,
+// centésimos de grau pra int16_t).
+// - insert/remove travam só a fatia do valor (exclusivo), então threads com temperaturas
+//   em fatias diferentes não esperam umas pelas outras
+// - rangeQuery trava em modo compartilhado só as fatias que cruzam [x, y]; leitores nunca
+//   esperam outros leitores e só seguram escritores daquelas fatias
+// - median/min/max/select não travam tudo: cada fatia tem um contador de versão (ímpar
+//   enquanto um escritor mexe) e a quantidade de valores em atômicos. O leitor tira uma
+//   foto das quantidades sem trava nenhuma (versões iguais antes e depois), descobre em
+//   quais fatias está a resposta e trava só essas, em modo compartilhado; se a versão delas
+//   mudou desde a foto, tenta de novo. Escritores das outras fatias nunca esperam. Depois de
+//   algumas tentativas perdidas (escrita sem parar) trava tudo, como antes.
+// Valores fora dos limites vão pras fatias das pontas.
+//
+// Por que não leitura otimista sem trava: a AVL libera nós no remove e nas remontagens,
+// e sem um esquema de reciclagem (épocas/hazard pointers) um leitor poderia andar num nó
+// já liberado. Com as fatias os leitores só bloqueiam a parte que estão lendo.
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <thread>
+#include <utility>
+#include <cstdint>
+
+#include "avl_tree.hpp"
+
+template <typename Key = double, typename Compare = std::less<Key>>
+class ConcurrentAVLTree {
+public:
+    using key_type = Key;
+    using key_compare = Compare;
+
+private:
+    // Cada fatia numa linha de cache própria pra uma trava não disputar com a vizinha
+    struct alignas(64) Fatia {
+        mutable std::shared_mutex trava;
+        AVLTree<Key, Compare> arvore;
+        std::atomic<uint64_t> versao{0}; // ímpar durante uma escrita
+        std::atomic<int> quantos{0};     // arvore.count(), legível sem a trava
+    };
+
+    static const int TENTATIVAS = 8; // leituras otimistas antes de travar tudo
+
+    // Escrita numa fatia já travada (exclusivo): versão ímpar durante a mudança.
+    // Tudo seq_cst: o escritor já paga o mutex, e assim a foto do leitor não precisa de fence.
+    template <typename F>
+    static void escrever(Fatia& f, F&& mudar) {
+        f.versao.fetch_add(1);
+        mudar(f.arvore);
+        f.quantos.store(f.arvore.count());
+        f.versao.fetch_add(1);
+    }
+
+    std::vector<std::unique_ptr<Fatia>> fatias;
+    std::vector<Key> limites;   // limites[i] = primeira chave da fatia i+1 (ordenados por comp)
+    Compare comp;
+    std::atomic<long> total{0};
+
+    size_t fatiaDe(Key v) const {
+        return std::upper_bound(limites.begin(), limites.end(), v, comp) - limites.begin();
+    }
+
+    // Trava em modo compartilhado as fatias [a, b] (em ordem crescente de índice)
+    std::vector<std::shared_lock<std::shared_mutex>> lerFatias(size_t a, size_t b) const {
+        std::vector<std::shared_lock<std::shared_mutex>> travas;
+        travas.reserve(b - a + 1);
+        for (size_t i = a; i <= b; i++) travas.emplace_back(fatias[i]->trava);
+        return travas;
+    }
+    auto lerTudo() const { return lerFatias(0, fatias.size() - 1); }
+
+    // Foto das quantidades sem trava: vale se nenhuma versão era ímpar nem mudou durante a leitura
+    bool fotografar(std::vector<uint64_t>& versoes, std::vector<int>& quantos) const {
+        size_t n = fatias.size();
+        versoes.resize(n);
+        quantos.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            versoes[i] = fatias[i]->versao.load();
+            if (versoes[i] & 1) return false;
+        }
+        for (size_t i = 0; i < n; i++) quantos[i] = fatias[i]->quantos.load();
+        for (size_t i = 0; i < n; i++) {
+            if (fatias[i]->versao.load() != versoes[i]) return false;
+        }
+        return true;
+    }
+
+    // Fatia onde fica a posição global k (pelas quantidades da foto) e o k dentro dela
+    static std::pair<size_t, int> localizar(const std::vector<int>& quantos, int k) {
+        size_t i = 0;
+        while (i + 1 < quantos.size() && k >= quantos[i]) k -= quantos[i++];
+        return {i, k};
+    }
+
+    // Leitura otimista: escolher(quantos) diz quais fatias [a, b] a resposta usa; elas são
+    // travadas pra leitura e, se continuam na versão da foto, ler(quantos, a, b) responde
+    // (as outras fatias podem mudar à vontade: a resposta é a do momento da foto).
+    template <typename Escolher, typename Ler>
+    auto lerOtimista(Escolher&& escolher, Ler&& ler) {
+        std::vector<uint64_t> versoes;
+        std::vector<int> quantos;
+        for (int t = 0; t < TENTATIVAS; t++) {
+            if (!fotografar(versoes, quantos)) {
+                std::this_thread::yield();
+                continue;
+            }
+            auto [a, b] = escolher(quantos);
+            auto travas = lerFatias(a, b);
+            bool iguais = true;
+            for (size_t i = a; i <= b && iguais; i++)
+                iguais = fatias[i]->versao.load() == versoes[i];
+            if (iguais) return ler(quantos, a, b);
+        }
+        auto travas = lerTudo();
+        for (size_t i = 0; i < fatias.size(); i++) quantos[i] = fatias[i]->arvore.count();
+        auto [a, b] = escolher(quantos);
+        return ler(quantos, a, b);
+    }
+
+    static int somar(const std::vector<int>& quantos) {
+        int n = 0;
+        for (int q : quantos) n += q;
+        return n;
+    }
+
+    // Cria as fatias pros limites já montados (repetidos viram um só: uma fatia vazia não ajuda)
+    void criarFatias() {
+        std::sort(limites.begin(), limites.end(), comp);
+        limites.erase(std::unique(limites.begin(), limites.end(),
+                                  [&](const Key& a, const Key& b) { return !comp(a, b) && !comp(b, a); }),
+                      limites.end());
+        for (size_t i = 0; i <= limites.size(); i++) fatias.push_back(std::make_unique<Fatia>());
+    }
+
+public:
+    // Limites nos quantis da amostra (por exemplo as leituras do último dia): com a amostra
+    // parecida com o que vai chegar, cada fatia recebe ~1/numFatias das escritas.
+    // Amostra vazia dá uma fatia só.
+    explicit ConcurrentAVLTree(std::span<const Key> amostra, int numFatias = 64) {
+        numFatias = std::max(1, numFatias);
+        std::vector<Key> ordenada(amostra.begin(), amostra.end());
+        std::sort(ordenada.begin(), ordenada.end(), comp);
+        if (!ordenada.empty()) {
+            for (int i = 1; i < numFatias; i++) limites.push_back(ordenada[ordenada.size() * i / numFatias]);
+        }
+        criarFatias();
+    }
+
+    // Limites fixos, divididos por igual entre minV e maxV, na unidade da chave
+    // (int16_t: centésimos de grau, então -10 °C a 45 °C é -1000 a 4500)
+    ConcurrentAVLTree(Key minV, Key maxV, int numFatias = 64) {
+        numFatias = std::max(1, numFatias);
+        for (int i = 1; i < numFatias; i++)
+            limites.push_back(static_cast<Key>((double)minV + ((double)maxV - (double)minV) * i / numFatias));
+        criarFatias();
+    }
+    ConcurrentAVLTree(const ConcurrentAVLTree&) = delete;
+    ConcurrentAVLTree& operator=(const ConcurrentAVLTree&) = delete;
+
+    size_t numFatias() const { return fatias.size(); }
+
+    void insert(Key value) {
+        Fatia& f = *fatias[fatiaDe(value)];
+        std::unique_lock lock(f.trava);
+        escrever(f, [&](auto& arvore) { arvore.insert(value); });
+        total.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void remove(Key value) {
+        Fatia& f = *fatias[fatiaDe(value)];
+        std::unique_lock lock(f.trava);
+        int antes = f.arvore.count();
+        escrever(f, [&](auto& arvore) { arvore.remove(value); });
+        total.fetch_sub(antes - f.arvore.count(), std::memory_order_relaxed);
+    }
+
+    // Lote: separa por fatia e trava cada fatia uma vez só (usa o insertBatch da AVL)
+    void insertBatch(std::span<const Key> batch) {
+        std::vector<std::vector<Key>> porFatia(fatias.size());
+        for (Key v : batch) porFatia[fatiaDe(v)].push_back(v);
+        for (size_t i = 0; i < fatias.size(); i++) {
+            if (porFatia[i].empty()) continue;
+            std::unique_lock lock(fatias[i]->trava);
+            escrever(*fatias[i], [&](auto& arvore) { arvore.insertBatch(porFatia[i]); });
+        }
+        total.fetch_add((long)batch.size(), std::memory_order_relaxed);
+    }
+
+    // Contagem sem trava (pode estar no meio de uma inserção de outra thread)
+    size_t count() const { return (size_t)total.load(std::memory_order_relaxed); }
+    bool isEmpty() const { return count() == 0; }
+
+    Key select(int k) {
+        return lerOtimista(
+            [&](const std::vector<int>& q) { size_t i = localizar(q, k).first; return std::pair{i, i}; },
+            [&](const std::vector<int>& q, size_t a, size_t) {
+                int local = localizar(q, k).second;
+                return local < q[a] ? fatias[a]->arvore.select(local) : Key{};
+            });
+    }
+
+    // Os dois do meio podem estar em fatias vizinhas: trava as duas
+    double median() {
+        return lerOtimista(
+            [&](const std::vector<int>& q) {
+                int n = somar(q);
+                if (n == 0) return std::pair<size_t, size_t>{0, 0};
+                return std::pair{localizar(q, (n - 1) / 2).first, localizar(q, n / 2).first};
+            },
+            [&](const std::vector<int>& q, size_t, size_t) {
+                int n = somar(q);
+                if (n == 0) return 0.0;
+                auto [i, k] = localizar(q, n / 2);
+                double meio = fatias[i]->arvore.select(k);
+                if (n % 2 != 0) return meio;
+                auto [j, l] = localizar(q, n / 2 - 1);
+                return ((double)fatias[j]->arvore.select(l) + meio) / 2.0;
+            });
+    }
+
+    int rangeCount(Key x, Key y) {
+        if (comp(y, x)) return 0;
+        size_t a = fatiaDe(x), b = fatiaDe(y);
+        auto travas = lerFatias(a, b);
+        int c = 0;
+        for (size_t i = a; i <= b; i++) c += fatias[i]->arvore.rangeCount(x, y);
+        return c;
+    }
+
+    // Chama visit(valor) em ordem crescente pra cada valor em [x, y] (fatias travadas pra leitura
+    // durante a visita inteira: o visitante não pode inserir/remover nesta árvore)
+    template <typename F>
+    size_t forEachInRange(Key x, Key y, F&& visit) {
+        if (comp(y, x)) return 0;
+        size_t a = fatiaDe(x), b = fatiaDe(y);
+        auto travas = lerFatias(a, b);
+        size_t n = 0;
+        bool parar = false;
+        for (size_t i = a; i <= b && !parar; i++) {
+            n += fatias[i]->arvore.forEachInRange(x, y, [&](Key v) { return !(parar = !visit(v)); });
+        }
+        return n;
+    }
+
+    std::vector<Key> rangeQuery(Key x, Key y) {
+        std::vector<Key> res;
+        if (comp(y, x)) return res;
+        size_t a = fatiaDe(x), b = fatiaDe(y);
+        auto travas = lerFatias(a, b);
+        size_t c = 0;
+        for (size_t i = a; i <= b; i++) c += fatias[i]->arvore.rangeCount(x, y);
+        res.reserve(c);
+        for (size_t i = a; i <= b; i++) fatias[i]->arvore.rangeQuery(x, y, std::back_inserter(res));
+        return res;
+    }
+
+    // Os n menores/maiores: trava só as fatias da ponta que têm os n (pela foto) e pega de
+    // cada uma só o que falta (min/max da AVL param depois de n)
+    std::vector<Key> min(int n) {
+        return lerOtimista(
+            [&](const std::vector<int>& q) {
+                int m = std::min(n, somar(q));
+                return std::pair<size_t, size_t>{0, m > 0 ? localizar(q, m - 1).first : 0};
+            },
+            [&](const std::vector<int>&, size_t, size_t b) {
+                std::vector<Key> res;
+                for (size_t i = 0; i <= b && (int)res.size() < n; i++) {
+                    std::vector<Key> parte = fatias[i]->arvore.min(n - (int)res.size());
+                    res.insert(res.end(), parte.begin(), parte.end());
+                }
+                return res;
+            });
+    }
+
+    std::vector<Key> max(int n) {
+        return lerOtimista(
+            [&](const std::vector<int>& q) {
+                int total = somar(q), m = std::min(n, total);
+                return std::pair<size_t, size_t>{m > 0 ? localizar(q, total - m).first : q.size() - 1, q.size() - 1};
+            },
+            [&](const std::vector<int>&, size_t a, size_t) {
+                std::vector<Key> res;
+                for (size_t i = fatias.size(); i-- > a && (int)res.size() < n;) {
+                    std::vector<Key> parte = fatias[i]->arvore.max(n - (int)res.size());
+                    res.insert(res.end(), parte.begin(), parte.end());
+                }
+                return res;
+            });
+    }
+
+    size_t bytesUsed() {
+        auto travas = lerTudo();
+        size_t b = fatias.size() * sizeof(Fatia) + limites.capacity() * sizeof(Key);
+        for (auto& f : fatias) b += f->arvore.bytesUsed();
+        return b;
+    }
+};
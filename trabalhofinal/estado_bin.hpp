@@ -0,0 +1,208 @@
+// Estado dos índices em binário (save/load de AVLTree, PureMinHeap e VectorInsertionSort)
+//
+// [cabeçalho de 64 bytes][valores]
+//   magic "IDXESTA1", versão do formato, qual estrutura gravou, tamanho e tipo da chave,
+//   quantidade, um campo extra da estrutura (aridade do heap, prefixo ordenado do vetor),
+//   offset dos dados, a soma de verificação dos valores e a geração do log de operações
+//   que continua este estado (log_operacoes.hpp; 0 quando não tem log).
+//
+// Cada estrutura grava os valores já na ordem dela (AVL em ordem, heap o array como está,
+// vetor o array com o prefixo ordenado), então o load mapeia o arquivo, confere e remonta
+// em O(N) sem ordenar nada. O arquivo é escrito num .tmp, vai pro disco (fsync) e só então
+// é renomeado, com um fsync da pasta depois: se o processo ou a máquina cair no meio do
+// save, fica o estado anterior inteiro ou o novo inteiro, nunca um arquivo vazio ou pela metade.
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <span>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <bit>
+#include <type_traits>
+#include <filesystem>
+
+#include "arquivo_mapeado.hpp"
+
+const char ESTADO_MAGIC[8] = {'I', 'D', 'X', 'E', 'S', 'T', 'A', '1'};
+const uint32_t ESTADO_VERSAO = 1;
+const uint64_t ESTADO_OFFSET = 64;
+
+enum TipoEstado : uint32_t {
+    ESTADO_AVL = 0,   // valores em ordem (percurso em ordem da árvore)
+    ESTADO_HEAP = 1,  // array do heap como está; extra = aridade
+    ESTADO_VETOR = 2  // array do vetor; extra = tamanho do prefixo ordenado
+};
+
+struct CabecalhoEstado {
+    char magic[8];
+    uint32_t versao;
+    uint32_t tipo;
+    uint32_t tamanhoChave; // sizeof(Key)
+    uint32_t chaveInteira; // 1 pra chave inteira (int16 em centésimos), 0 pra ponto flutuante
+    uint64_t quantidade;
+    uint64_t extra;
+    uint64_t offsetDados;
+    uint64_t soma;         // somaVerificacao dos valores
+    uint64_t geracaoLog;   // o log com essa geração (ou mais nova) vem depois deste estado
+};
+static_assert(sizeof(CabecalhoEstado) == ESTADO_OFFSET, "cabecalho tem que ter 64 bytes");
+
+// Soma de verificação dos bytes: não é criptográfica, só pega arquivo cortado ou corrompido.
+// Quatro acumuladores de 64 bits independentes pra não ficar esperando uma multiplicação
+// terminar antes da outra (passa de vários GB/s, não pesa no load).
+inline uint64_t somaVerificacao(const void* dados, size_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(dados);
+    const uint64_t M = 0x9E3779B97F4A7C15ull;
+    uint64_t h[4] = {M, M + 1, M + 2, M + 3};
+    size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        for (int l = 0; l < 4; l++) {
+            uint64_t w;
+            std::memcpy(&w, p + i + 8 * l, 8);
+            h[l] = std::rotl((h[l] ^ w) * M, 31);
+        }
+    }
+    uint64_t r = bytes * M;
+    for (int l = 0; l < 4; l++) r = std::rotl((r ^ h[l]) * M, 27);
+    for (; i < bytes; i++) r = (r ^ p[i]) * 0x100000001B3ull;
+    return r ^ (r >> 32);
+}
+
+// Troca `arquivo` por cabeçalho + dados de forma atômica e durável: escreve num .tmp, fsync
+// nele, rename por cima e fsync da pasta (senão o rename pode não ter chegado no disco e,
+// depois de uma queda, o nome aponta pro arquivo novo sem os dados dele).
+// Fora de Unix não tem fsync: só flush e rename.
+inline bool substituirArquivo(const std::string& arquivo, const void* cab, size_t bytesCab, const void* dados,
+                              size_t bytesDados) {
+    std::string tmp = arquivo + ".tmp";
+#ifdef ARQUIVO_MMAP
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Erro ao criar " << tmp << std::endl;
+        return false;
+    }
+    auto escreverTudo = [fd](const void* dadosParte, size_t n) {
+        const char* p = static_cast<const char*>(dadosParte);
+        while (n > 0) {
+            ssize_t w = ::write(fd, p, n);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) return false;
+            p += w;
+            n -= (size_t)w;
+        }
+        return true;
+    };
+    bool ok = escreverTudo(cab, bytesCab) && escreverTudo(dados, bytesDados) && fsync(fd) == 0;
+    ok = (::close(fd) == 0) && ok;
+#else
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Erro ao criar " << tmp << std::endl;
+        return false;
+    }
+    out.write(static_cast<const char*>(cab), bytesCab);
+    out.write(static_cast<const char*>(dados), bytesDados);
+    out.close();
+    bool ok = !out.fail();
+#endif
+    // Daqui pra frente o .tmp existe: qualquer falha apaga ele (senão sobra no disco)
+    std::error_code erro;
+    if (!ok) {
+        std::cerr << "Erro ao escrever " << tmp << std::endl;
+        std::filesystem::remove(tmp, erro);
+        return false;
+    }
+    std::filesystem::rename(tmp, arquivo, erro);
+    if (erro) {
+        std::cerr << "Erro ao renomear " << tmp << ": " << erro.message() << std::endl;
+        std::filesystem::remove(tmp, erro);
+        return false;
+    }
+#ifdef ARQUIVO_MMAP
+    std::string pasta = std::filesystem::path(arquivo).parent_path().string();
+    int dfd = ::open(pasta.empty() ? "." : pasta.c_str(), O_RDONLY | O_DIRECTORY);
+    // EINVAL: sistema de arquivos que não sincroniza pasta (aí não tem o que fazer)
+    bool pastaOk = dfd >= 0 && (fsync(dfd) == 0 || errno == EINVAL);
+    if (dfd >= 0) ::close(dfd);
+    if (!pastaOk) {
+        std::cerr << "Erro no fsync da pasta de " << arquivo << std::endl;
+        return false;
+    }
+#endif
+    return true;
+}
+
+// Grava `valores` com o cabeçalho. Retorna false se não conseguir escrever.
+template <typename Key>
+bool salvarEstado(const std::string& arquivo, TipoEstado tipo, std::span<const Key> valores, uint64_t extra = 0,
+                  uint64_t geracaoLog = 0) {
+    CabecalhoEstado cab{};
+    std::memcpy(cab.magic, ESTADO_MAGIC, sizeof(cab.magic));
+    cab.versao = ESTADO_VERSAO;
+    cab.tipo = tipo;
+    cab.tamanhoChave = sizeof(Key);
+    cab.chaveInteira = std::is_integral_v<Key>;
+    cab.quantidade = valores.size();
+    cab.extra = extra;
+    cab.offsetDados = ESTADO_OFFSET;
+    cab.soma = somaVerificacao(valores.data(), valores.size_bytes());
+    cab.geracaoLog = geracaoLog;
+
+    return substituirArquivo(arquivo, &cab, sizeof(cab), valores.data(), valores.size_bytes());
+}
+
+// Estado gravado por salvarEstado, mapeado na memória (os valores não são copiados)
+template <typename Key>
+class EstadoMapeado {
+private:
+    ArquivoMapeado arquivo; // vazio enquanto não abriu um arquivo válido
+    CabecalhoEstado cab{};
+
+    bool recusar(const std::string& caminho, const char* motivo) {
+        std::cerr << "Estado invalido (" << motivo << "): " << caminho << std::endl;
+        arquivo.fechar();
+        return false;
+    }
+
+public:
+    // Abre e confere magic, versão, estrutura, tipo da chave, tamanho e soma de verificação.
+    // Arquivo que não existe só retorna false (primeira execução); inválido avisa no cerr.
+    bool abrir(const std::string& caminho, TipoEstado esperado) {
+        if (!arquivo.abrir(caminho)) return false;
+        if (arquivo.tamanho() < sizeof(CabecalhoEstado)) return recusar(caminho, "arquivo curto");
+        std::memcpy(&cab, arquivo.dados(), sizeof(cab));
+        if (std::memcmp(cab.magic, ESTADO_MAGIC, sizeof(cab.magic)) != 0) return recusar(caminho, "formato");
+        if (cab.versao == 0 || cab.versao > ESTADO_VERSAO) return recusar(caminho, "versao");
+        if (cab.tipo != esperado) return recusar(caminho, "gravado por outra estrutura");
+        if (cab.tamanhoChave != sizeof(Key) || cab.chaveInteira != std::is_integral_v<Key>)
+            return recusar(caminho, "tipo da chave");
+        if (cab.offsetDados < sizeof(CabecalhoEstado) || cab.offsetDados % alignof(Key) != 0
+            || cab.offsetDados > arquivo.tamanho()
+            || cab.quantidade > (arquivo.tamanho() - cab.offsetDados) / sizeof(Key))
+            return recusar(caminho, "tamanho");
+        if (somaVerificacao(arquivo.dados() + cab.offsetDados, cab.quantidade * sizeof(Key)) != cab.soma)
+            return recusar(caminho, "soma de verificacao");
+        return true;
+    }
+
+    std::span<const Key> valores() const {
+        if (!arquivo.dados()) return {};
+        return {reinterpret_cast<const Key*>(arquivo.dados() + cab.offsetDados), cab.quantidade};
+    }
+
+    uint64_t extra() const { return cab.extra; }
+    uint64_t geracaoLog() const { return cab.geracaoLog; }
+};
+
+// Só a geração do log gravada no cabeçalho (0 se o arquivo não existe ou não é um estado).
+// Não confere a soma: é pra ser chamada depois de um load() que já conferiu.
+inline uint64_t geracaoLogDoEstado(const std::string& arquivo) {
+    CabecalhoEstado cab{};
+    std::ifstream in(arquivo, std::ios::binary);
+    if (!in.read(reinterpret_cast<char*>(&cab), sizeof(cab))) return 0;
+    if (std::memcmp(cab.magic, ESTADO_MAGIC, sizeof(cab.magic)) != 0) return 0;
+    return cab.geracaoLog;
+}
@@ -0,0 +1,199 @@
+// Histograma quantizado (Fenwick tree)
+// As leituras têm 2 casas decimais em [-10.00, 45.00]: só 5501 chaves possíveis.
+// Guarda a contagem de cada chave + uma Fenwick tree das contagens, então a memória
+// não depende de N. Valores fora da faixa (e NaN) não entram: insert devolve false e
+// conta em foraDaFaixa() (prender no limite fazia insert(50) virar um 45.00 e remove(100)
+// apagar um 45.00 de verdade). Nas consultas, x e y fora da faixa funcionam normalmente.
+//
+// Key é o tipo que entra e sai (double, float ou int16). Pra int16 em centésimos
+// a faixa e a escala vão na mesma unidade: FenwickHistogram<int16_t>(-1000, 4500, 1).
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "indice.hpp"
+
+template <typename Key = double>
+class FenwickHistogram {
+public:
+    using key_type = Key;
+    using key_compare = std::less<Key>;
+
+private:
+    long base;               // menor chave em unidades inteiras (ex.: -1000 centésimos)
+    int escala;              // unidades por valor (100 = 2 casas decimais)
+    int D;                   // quantidade de chaves
+    std::vector<int> counts; // contagem de cada chave
+    std::vector<int> tree;   // Fenwick tree (índice 1..D)
+    int topBit = 1;          // maior potência de 2 <= D (pro select)
+
+    int total = 0;
+    size_t rejeitados = 0;   // inserts fora da faixa
+
+    // Chave mais próxima dentro da faixa (pras consultas: rank(100) conta tudo). Prende em
+    // double antes de converter: lround de infinito ou de valor enorme não tem resultado definido.
+    int toKey(double v) {
+        double u = std::round(v * escala) - base;
+        if (!(u > 0)) return 0; // inclui -inf e NaN
+        if (u >= D - 1) return D - 1;
+        return (int)u;
+    }
+    // Chave exata do valor, ou false se ele não cabe na faixa (pra insert/remove)
+    bool chaveNaFaixa(double v, int& k) {
+        double u = std::round(v * escala) - base; // em double: NaN e valores enormes não passam
+        if (!(u >= 0 && u < D)) return false;
+        k = (int)u;
+        return true;
+    }
+    // Divide por inteiro pra dar exatamente o mesmo double que "22.50" no CSV
+    Key toValue(int k) { return static_cast<Key>((double)(base + k) / escala); }
+
+    void add(int k, int delta) {
+        for (int i = k + 1; i <= D; i += i & -i) tree[i] += delta;
+    }
+
+    // Soma das contagens das chaves [0, k]
+    int prefix(int k) {
+        int s = 0;
+        for (int i = k + 1; i > 0; i -= i & -i) s += tree[i];
+        return s;
+    }
+
+    // Primeira e última chave dentro de [x, y]
+    void keyRange(Key x, Key y, int& a, int& b) {
+        a = toKey(x); b = toKey(y);
+        if (toValue(a) < x) a++;
+        if (toValue(b) > y) b--;
+    }
+
+public:
+    FenwickHistogram(double minV = -10.0, double maxV = 45.0, int escalaV = 100) : escala(escalaV) {
+        base = std::lround(minV * escala);
+        D = (int)(std::lround(maxV * escala) - base) + 1;
+        counts.assign(D, 0);
+        tree.assign(D + 1, 0);
+        while (topBit * 2 <= D) topBit *= 2;
+    }
+
+    // O(log D), D fixo (~13 passos pra 5501 chaves). false = fora da faixa, não entrou.
+    bool insert(Key value) {
+        int k;
+        if (!chaveNaFaixa(value, k)) {
+            rejeitados++;
+            return false;
+        }
+        counts[k]++;
+        add(k, 1);
+        total++;
+        return true;
+    }
+
+    // Remove uma ocorrência (se existir): O(1) pra checar + O(log D)
+    bool remove(Key value) {
+        int k;
+        if (!chaveNaFaixa(value, k) || counts[k] == 0) return false;
+        counts[k]--;
+        add(k, -1);
+        total--;
+        return true;
+    }
+
+    int count() { return total; }
+    size_t foraDaFaixa() const { return rejeitados; }
+    bool isEmpty() { return total == 0; }
+
+    // k-ésimo menor (k começa em 0): desce na Fenwick tree em O(log D)
+    Key select(int k) {
+        if (k < 0 || k >= total) return Key{};
+        int pos = 0;
+        for (int b = topBit; b > 0; b /= 2) {
+            if (pos + b <= D && tree[pos + b] <= k) {
+                pos += b;
+                k -= tree[pos];
+            }
+        }
+        return toValue(pos); // pos é a chave (0-based) do k-ésimo
+    }
+
+    // Quantos valores são menores que x
+    int rank(Key x) {
+        int k = toKey(x);
+        int r = (k > 0) ? prefix(k - 1) : 0;
+        if (toValue(k) < x) r += counts[k]; // x caiu entre duas chaves
+        return r;
+    }
+
+    // Quantos valores em [x, y]: O(log D)
+    int rangeCount(Key x, Key y) {
+        if (x > y) return 0;
+        int a, b;
+        keyRange(x, y, a, b);
+        if (a > b) return 0;
+        return prefix(b) - (a > 0 ? prefix(a - 1) : 0);
+    }
+
+    double median() {
+        if (total == 0) return 0.0;
+        if (total % 2 != 0) return select(total / 2);
+        else return ((double)select(total / 2 - 1) + select(total / 2)) / 2.0;
+    }
+
+    // Os n menores: anda pelas chaves a partir da primeira não vazia
+    std::vector<Key> min(int n) {
+        std::vector<Key> res;
+        for (int k = 0; k < D && (int)res.size() < n; k++) {
+            for (int c = 0; c < counts[k] && (int)res.size() < n; c++) res.push_back(toValue(k));
+        }
+        return res;
+    }
+
+    // Os n maiores, do maior pro menor
+    std::vector<Key> max(int n) {
+        std::vector<Key> res;
+        for (int k = D - 1; k >= 0 && (int)res.size() < n; k--) {
+            for (int c = 0; c < counts[k] && (int)res.size() < n; c++) res.push_back(toValue(k));
+        }
+        return res;
+    }
+
+    // Lista os valores em [x, y] (percorre só as chaves do intervalo)
+    std::vector<Key> rangeQuery(Key x, Key y) {
+        std::vector<Key> result;
+        result.reserve(rangeCount(x, y));
+        forEachInRange(x, y, [&](Key v) { result.push_back(v); return true; });
+        return result;
+    }
+
+    // Versão sem alocação: chama visit(valor) pra cada valor em [x, y]
+    // em ordem crescente. visit retorna false pra parar antes. Retorna quantos foram visitados.
+    template <typename F>
+    size_t forEachInRange(Key x, Key y, F&& visit) {
+        size_t n = 0;
+        if (x > y) return n;
+        int a, b;
+        keyRange(x, y, a, b);
+        for (int k = a; k <= b; k++) {
+            for (int c = 0; c < counts[k]; c++) {
+                n++;
+                if (!visit(toValue(k))) return n;
+            }
+        }
+        return n;
+    }
+
+    // Escreve os valores de [x, y] num iterador de saída, parando depois de `limit`
+    template <typename OutIt>
+    OutIt rangeQuery(Key x, Key y, OutIt out, size_t limit = std::numeric_limits<size_t>::max()) {
+        if (limit == 0) return out;
+        size_t n = 0;
+        forEachInRange(x, y, [&](Key v) { *out++ = v; return ++n < limit; });
+        return out;
+    }
+
+    // Memória usada (não depende de quantas leituras tem)
+    size_t bytesUsed() { return (counts.size() + tree.size()) * sizeof(int); }
+};
@@ -0,0 +1,154 @@
+// Filtros de intervalo [lo, hi] pra busca linear (rangeQuery/rangeCount dos vetores)
+// - contarIntervalo: só conta, sem alocar nada
+// - filtrarIntervalo: copia os valores que passam, compactados, num buffer já alocado
+// Tem versão AVX2 (4 doubles por vez), SSE2 (2 por vez) e escalar sem if.
+// A versão é escolhida em tempo de execução conforme a CPU.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#if defined(__GNUC__) || defined(__clang__)
+#include <immintrin.h>
+#define FILTRO_X86 1
+#endif
+#endif
+
+// Quantos doubles a mais o buffer de saída precisa (as versões SIMD gravam o vetor inteiro)
+const size_t FILTRO_FOLGA = 4;
+
+// ---------- Escalar (serve pra qualquer CPU) ----------
+
+inline size_t contarIntervaloEscalar(const double* v, size_t n, double lo, double hi) {
+    size_t c = 0;
+    for (size_t i = 0; i < n; i++) c += (v[i] >= lo) & (v[i] <= hi);
+    return c;
+}
+
+// Grava sempre e só avança k quando passa (sem desvio)
+inline size_t filtrarIntervaloEscalar(const double* v, size_t n, double lo, double hi, double* out) {
+    size_t k = 0;
+    for (size_t i = 0; i < n; i++) {
+        out[k] = v[i];
+        k += (v[i] >= lo) & (v[i] <= hi);
+    }
+    return k;
+}
+
+#ifdef FILTRO_X86
+
+// ---------- SSE2 (todo x86-64 tem) ----------
+
+__attribute__((target("sse2")))
+inline size_t contarIntervaloSSE(const double* v, size_t n, double lo, double hi) {
+    __m128d vlo = _mm_set1_pd(lo), vhi = _mm_set1_pd(hi);
+    size_t c = 0, i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(v + i);
+        __m128d m = _mm_and_pd(_mm_cmpge_pd(x, vlo), _mm_cmple_pd(x, vhi));
+        c += __builtin_popcount(_mm_movemask_pd(m));
+    }
+    return c + contarIntervaloEscalar(v + i, n - i, lo, hi);
+}
+
+__attribute__((target("sse2")))
+inline size_t filtrarIntervaloSSE(const double* v, size_t n, double lo, double hi, double* out) {
+    __m128d vlo = _mm_set1_pd(lo), vhi = _mm_set1_pd(hi);
+    size_t k = 0, i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(v + i);
+        int m = _mm_movemask_pd(_mm_and_pd(_mm_cmpge_pd(x, vlo), _mm_cmple_pd(x, vhi)));
+        // Só 4 casos: nada, só o 0, só o 1, os dois
+        __m128d y = (m == 2) ? _mm_unpackhi_pd(x, x) : x;
+        _mm_storeu_pd(out + k, y);
+        k += __builtin_popcount(m);
+    }
+    return k + filtrarIntervaloEscalar(v + i, n - i, lo, hi, out + k);
+}
+
+// ---------- AVX2 ----------
+
+// Pra cada máscara de 4 bits, a permutação (em pares de int32) que junta os selecionados no começo
+alignas(32) inline const uint32_t FILTRO_PERM_AVX2[16][8] = {
+    {0,1,2,3,4,5,6,7}, {0,1,2,3,4,5,6,7}, {2,3,0,1,4,5,6,7}, {0,1,2,3,4,5,6,7},
+    {4,5,0,1,2,3,6,7}, {0,1,4,5,2,3,6,7}, {2,3,4,5,0,1,6,7}, {0,1,2,3,4,5,6,7},
+    {6,7,0,1,2,3,4,5}, {0,1,6,7,2,3,4,5}, {2,3,6,7,0,1,4,5}, {0,1,2,3,6,7,4,5},
+    {4,5,6,7,0,1,2,3}, {0,1,4,5,6,7,2,3}, {2,3,4,5,6,7,0,1}, {0,1,2,3,4,5,6,7},
+};
+
+__attribute__((target("avx2,popcnt")))
+inline size_t contarIntervaloAVX2(const double* v, size_t n, double lo, double hi) {
+    __m256d vlo = _mm256_set1_pd(lo), vhi = _mm256_set1_pd(hi);
+    size_t c = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(v + i);
+        __m256d m = _mm256_and_pd(_mm256_cmp_pd(x, vlo, _CMP_GE_OQ), _mm256_cmp_pd(x, vhi, _CMP_LE_OQ));
+        c += _mm_popcnt_u32(_mm256_movemask_pd(m));
+    }
+    return c + contarIntervaloEscalar(v + i, n - i, lo, hi);
+}
+
+__attribute__((target("avx2,popcnt")))
+inline size_t filtrarIntervaloAVX2(const double* v, size_t n, double lo, double hi, double* out) {
+    __m256d vlo = _mm256_set1_pd(lo), vhi = _mm256_set1_pd(hi);
+    size_t k = 0, i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(v + i);
+        int m = _mm256_movemask_pd(_mm256_and_pd(_mm256_cmp_pd(x, vlo, _CMP_GE_OQ),
+                                                 _mm256_cmp_pd(x, vhi, _CMP_LE_OQ)));
+        __m256i perm = _mm256_load_si256(reinterpret_cast<const __m256i*>(FILTRO_PERM_AVX2[m]));
+        __m256d y = _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(x), perm));
+        _mm256_storeu_pd(out + k, y);
+        k += _mm_popcnt_u32(m);
+    }
+    return k + filtrarIntervaloEscalar(v + i, n - i, lo, hi, out + k);
+}
+
+#endif
+
+// ---------- Escolha da versão (uma vez só) ----------
+
+enum NivelSIMD { SIMD_ESCALAR, SIMD_SSE2, SIMD_AVX2 };
+
+inline NivelSIMD nivelSIMD() {
+#ifdef FILTRO_X86
+    static const NivelSIMD nivel = __builtin_cpu_supports("avx2") ? SIMD_AVX2 : SIMD_SSE2;
+    return nivel;
+#else
+    return SIMD_ESCALAR;
+#endif
+}
+
+inline const char* nomeNivelSIMD() {
+    switch (nivelSIMD()) {
+        case SIMD_AVX2: return "AVX2";
+        case SIMD_SSE2: return "SSE2";
+        default: return "escalar";
+    }
+}
+
+// Conta quantos valores de v[0, n) estão em [lo, hi]. Não aloca nada.
+inline size_t contarIntervalo(const double* v, size_t n, double lo, double hi) {
+#ifdef FILTRO_X86
+    switch (nivelSIMD()) {
+        case SIMD_AVX2: return contarIntervaloAVX2(v, n, lo, hi);
+        case SIMD_SSE2: return contarIntervaloSSE(v, n, lo, hi);
+        default: break;
+    }
+#endif
+    return contarIntervaloEscalar(v, n, lo, hi);
+}
+
+// Copia os valores de v[0, n) que estão em [lo, hi] pro começo de out e retorna quantos são.
+// out tem que ter espaço pra (quantidade que passa + FILTRO_FOLGA) doubles.
+inline size_t filtrarIntervalo(const double* v, size_t n, double lo, double hi, double* out) {
+#ifdef FILTRO_X86
+    switch (nivelSIMD()) {
+        case SIMD_AVX2: return filtrarIntervaloAVX2(v, n, lo, hi, out);
+        case SIMD_SSE2: return filtrarIntervaloSSE(v, n, lo, hi, out);
+        default: break;
+    }
+#endif
+    return filtrarIntervaloEscalar(v, n, lo, hi, out);
+}
@@ -0,0 +1,213 @@
+// Gerador de leituras sintéticas com cara de sensor de verdade
+//
+//   uniforme   -> sorteio uniforme em [min, max] (o que o gerardados fazia)
+//   passeio    -> deriva lenta (passeio aleatório grosso + ruído pequeno): chega quase ordenado
+//   ordenada   -> crescente, com repetidos naturais das 2 casas decimais
+//   invertida  -> decrescente
+//   repetidos  -> só 32 valores diferentes
+//   zipf       -> poucos valores muito frequentes perto do meio da faixa, cauda longa
+//   picos      -> passeio com rajadas curtas de leituras nos extremos da faixa
+//
+// Tudo sai arredondado em 2 casas e dentro de [min, max], igual ao CSV.
+// A leitura i só depende da semente e de i: cada bloco de BLOCO leituras tem a própria
+// semente, então dá o mesmo arquivo com qualquer número de threads.
+#pragma once
+
+#include <vector>
+#include <string>
+#include <random>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+enum class Distribuicao { Uniforme, Passeio, Ordenada, Invertida, Repetidos, Zipf, Picos };
+
+struct InfoDistribuicao {
+    Distribuicao tipo;
+    const char* nome;
+};
+
+inline const InfoDistribuicao DISTRIBUICOES[] = {
+    {Distribuicao::Uniforme, "uniforme"}, {Distribuicao::Passeio, "passeio"},
+    {Distribuicao::Ordenada, "ordenada"}, {Distribuicao::Invertida, "invertida"},
+    {Distribuicao::Repetidos, "repetidos"}, {Distribuicao::Zipf, "zipf"},
+    {Distribuicao::Picos, "picos"},
+};
+
+// Acha a distribuição pelo nome. Retorna false se não existir.
+inline bool distribuicaoPorNome(const std::string& nome, Distribuicao& d) {
+    for (const InfoDistribuicao& info : DISTRIBUICOES) {
+        if (nome == info.nome) { d = info.tipo; return true; }
+    }
+    return false;
+}
+
+inline std::string nomesDistribuicoes() {
+    std::string s;
+    for (const InfoDistribuicao& info : DISTRIBUICOES) s += (s.empty() ? "" : ", ") + std::string(info.nome);
+    return s;
+}
+
+struct ConfigGerador {
+    Distribuicao dist = Distribuicao::Uniforme;
+    uint64_t semente = 42;
+    uint64_t n = 1000;
+    double minV = -10.0;
+    double maxV = 45.0;
+};
+
+class GeradorLeituras {
+public:
+    static constexpr size_t BLOCO = 1 << 16; // leituras por bloco (cada um com sua semente)
+    static constexpr size_t PASSO = 4096; // leituras entre dois pontos do passeio grosso
+
+private:
+    ConfigGerador cfg;
+    std::vector<double> passeio;   // pontos do passeio grosso (passeio e picos)
+    std::vector<double> valores;   // os 32 valores do "repetidos"
+    std::vector<double> cdfZipf;   // distribuição acumulada dos ranks do zipf
+
+    // Espalha bem os bits (splitmix64), pra semente de cada bloco não ficar parecida
+    static uint64_t misturar(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    double arredondar(double v) const {
+        return std::clamp(std::round(v * 100.0) / 100.0, cfg.minV, cfg.maxV);
+    }
+
+    // Posição do passeio grosso na leitura i (interpolação linear entre os pontos)
+    double deriva(uint64_t i) const {
+        size_t p = i / PASSO;
+        double f = (double)(i % PASSO) / PASSO;
+        return passeio[p] * (1.0 - f) + passeio[p + 1] * f;
+    }
+
+    // Rank r do zipf vira um valor: 0 é o meio da faixa, depois +0.01, -0.01, +0.02, ...
+    double valorZipf(size_t r) const {
+        double meio = std::round((cfg.minV + cfg.maxV) / 2.0 * 100.0) / 100.0;
+        double passo = (double)((r + 1) / 2) / 100.0;
+        return arredondar((r % 2) ? meio + passo : meio - passo);
+    }
+
+    void gerarBloco(uint64_t b, double* out, size_t len) const {
+        std::mt19937_64 gen(misturar(cfg.semente ^ misturar(b)));
+        std::uniform_real_distribution<double> uni(cfg.minV, cfg.maxV);
+        std::uniform_real_distribution<double> u01(0.0, 1.0);
+        std::normal_distribution<double> ruido(0.0, 0.05);
+        uint64_t inicio = b * BLOCO;
+        double faixa = cfg.maxV - cfg.minV;
+        double ultimo = cfg.n > 1 ? (double)(cfg.n - 1) : 1.0;
+        int surto = 0; // leituras que ainda faltam na rajada atual (picos)
+        bool surtoAlto = true;
+
+        for (size_t k = 0; k < len; k++) {
+            uint64_t i = inicio + k;
+            double v;
+            switch (cfg.dist) {
+                case Distribuicao::Uniforme: v = uni(gen); break;
+                case Distribuicao::Ordenada: v = cfg.minV + faixa * (i / ultimo); break;
+                case Distribuicao::Invertida: v = cfg.maxV - faixa * (i / ultimo); break;
+                case Distribuicao::Passeio: v = deriva(i) + ruido(gen); break;
+                case Distribuicao::Repetidos: v = valores[gen() % valores.size()]; break;
+                case Distribuicao::Zipf: {
+                    size_t r = std::upper_bound(cdfZipf.begin(), cdfZipf.end(), u01(gen)) - cdfZipf.begin();
+                    v = valorZipf(std::min(r, cdfZipf.size() - 1));
+                    break;
+                }
+                case Distribuicao::Picos:
+                default:
+                    if (surto == 0 && u01(gen) < 0.001) {
+                        surto = 1 + gen() % 32;
+                        surtoAlto = gen() % 2;
+                    }
+                    if (surto > 0) {
+                        surto--;
+                        double extremo = surtoAlto ? cfg.maxV - u01(gen) * 2.0 : cfg.minV + u01(gen) * 2.0;
+                        v = extremo;
+                    } else {
+                        v = deriva(i) + ruido(gen);
+                    }
+                    break;
+            }
+            out[k] = arredondar(v);
+        }
+    }
+
+public:
+    explicit GeradorLeituras(const ConfigGerador& c) : cfg(c) {
+        double faixa = cfg.maxV - cfg.minV;
+        std::mt19937_64 gen(misturar(cfg.semente));
+        if (cfg.dist == Distribuicao::Passeio || cfg.dist == Distribuicao::Picos) {
+            // Um ponto a cada PASSO leituras, andando devagar e refletindo nas bordas
+            std::normal_distribution<double> passo(0.0, faixa / 200.0);
+            size_t pontos = cfg.n / PASSO + 2;
+            passeio.resize(pontos);
+            double x = cfg.minV + faixa / 2.0;
+            for (size_t p = 0; p < pontos; p++) {
+                passeio[p] = x;
+                x += passo(gen);
+                if (x < cfg.minV) x = 2 * cfg.minV - x;
+                if (x > cfg.maxV) x = 2 * cfg.maxV - x;
+            }
+        } else if (cfg.dist == Distribuicao::Repetidos) {
+            std::uniform_real_distribution<double> uni(cfg.minV, cfg.maxV);
+            for (int k = 0; k < 32; k++) valores.push_back(arredondar(uni(gen)));
+        } else if (cfg.dist == Distribuicao::Zipf) {
+            // Peso 1/(r+1)^1.2 pra cada valor possível da faixa (2 casas)
+            size_t chaves = (size_t)std::llround(faixa * 100.0) + 1;
+            cdfZipf.resize(chaves);
+            double soma = 0;
+            for (size_t r = 0; r < chaves; r++) cdfZipf[r] = (soma += 1.0 / std::pow(r + 1.0, 1.2));
+            for (double& c : cdfZipf) c /= soma;
+        }
+    }
+
+    const ConfigGerador& config() const { return cfg; }
+
+    // Preenche out com as leituras [inicio, inicio + quantidade)
+    void gerar(uint64_t inicio, size_t quantidade, double* out) const {
+        std::vector<double> temp;
+        uint64_t fim = std::min<uint64_t>(inicio + quantidade, cfg.n);
+        for (uint64_t b = inicio / BLOCO; b * BLOCO < fim; b++) {
+            uint64_t ini = b * BLOCO;
+            size_t len = (size_t)std::min<uint64_t>(BLOCO, cfg.n - ini);
+            uint64_t de = std::max(ini, inicio), ate = std::min(ini + len, fim);
+            if (de == ini && ate == ini + len) {
+                gerarBloco(b, out + (ini - inicio), len); // bloco inteiro: direto na saída
+            } else {
+                temp.resize(len);
+                gerarBloco(b, temp.data(), len);
+                std::copy(temp.begin() + (de - ini), temp.begin() + (ate - ini), out + (de - inicio));
+            }
+        }
+    }
+};
+
+// Gera as n leituras inteiras na memória, dividindo os blocos entre as threads
+inline std::vector<double> gerarLeituras(const ConfigGerador& cfg, unsigned threads = 0) {
+    GeradorLeituras g(cfg);
+    std::vector<double> v(cfg.n);
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t blocos = (cfg.n + GeradorLeituras::BLOCO - 1) / GeradorLeituras::BLOCO;
+    threads = (unsigned)std::min<size_t>(threads, std::max<size_t>(blocos, 1));
+    if (threads <= 1) {
+        g.gerar(0, cfg.n, v.data());
+        return v;
+    }
+    std::vector<std::thread> ts;
+    for (unsigned t = 0; t < threads; t++) {
+        ts.emplace_back([&, t] {
+            for (size_t b = t; b < blocos; b += threads) {
+                uint64_t ini = b * GeradorLeituras::BLOCO;
+                g.gerar(ini, std::min<uint64_t>(GeradorLeituras::BLOCO, cfg.n - ini), v.data() + ini);
+            }
+        });
+    }
+    for (auto& t : ts) t.join();
+    return v;
+}
@@ -1,42 +1,219 @@
 // Bibliotecas que vou usar
 #include <iostream>
 #include <fstream>
-#include <random>
-#include <iomanip>
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
 
-int main() {
-    // Parâmetros do arquivo e dos dados
-    const std::string nome_arquivo = "temperaturas.csv";
-    const int qtd_dados = 1000;
-    const double temp_min = -10.0;
-    const double temp_max = 45.0;
+#include "leituras_bin.hpp"
+#include "gerador.hpp"
+
+// Uso: ./gerar [opções]
+//   --n N          quantidade de leituras (aceita 1e9; padrão 1000)
+//   --dist D       uniforme, passeio, ordenada, invertida, repetidos, zipf ou picos (padrão uniforme)
+//   --seed S       semente (padrão 42: sempre o mesmo arquivo)
+//   --min A --max B  faixa das temperaturas (padrão -10 a 45)
+//   --threads T    threads gerando/formatando (padrão: todas)
+//   --saida base   nome dos arquivos sem extensão (padrão temperaturas)
+//   --bin          também grava base.bin com os valores em double
+//   --bin16        também grava base.bin em int16 (centésimos de grau, 4x menor)
+//   --sem-csv      não grava o CSV (só faz sentido com --bin/--bin16)
+
+// O que uma thread produz numa rodada: o texto do CSV e os bytes do .bin
+struct Pedaco {
+    std::vector<double> valores;
+    std::string csv;
+    std::vector<char> bin;
+    bool erro = false; // algum valor não coube na linha do CSV
+};
 
-    // Abre o arquivo pra escrever
-    std::ofstream arquivo(nome_arquivo);
+// Tamanho máximo de uma linha do CSV ("-10.00\n" = 7 com a faixa padrão): as leituras ficam
+// em [minV, maxV], então a mais larga tem no máximo a largura do limite mais largo
+size_t larguraLinha(double minV, double maxV) {
+    char tmp[512];
+    size_t maior = 0;
+    for (double v : {minV, maxV}) {
+        auto res = std::to_chars(tmp, tmp + sizeof(tmp), v, std::chars_format::fixed, 2);
+        maior = std::max(maior, res.ec == std::errc() ? (size_t)(res.ptr - tmp) : sizeof(tmp));
+    }
+    return maior + 1; // '\n'
+}
 
-    if (!arquivo.is_open()) {
-        std::cerr << "Erro ao criar o arquivo " << nome_arquivo << "!" << std::endl;
+// Gera as leituras [inicio, inicio + len) e já formata pro(s) arquivo(s)
+void produzirPedaco(const GeradorLeituras& gerador, uint64_t inicio, size_t len, bool csv, size_t largura, bool bin,
+                    TipoLeitura tipo, Pedaco& p) {
+    p.valores.resize(len);
+    gerador.gerar(inicio, len, p.valores.data());
+    if (csv) {
+        p.csv.resize(len * largura);
+        char* w = p.csv.data();
+        char* fim = p.csv.data() + p.csv.size();
+        for (double v : p.valores) {
+            auto res = std::to_chars(w, fim, v, std::chars_format::fixed, 2); // igual ao setprecision(2)
+            if (res.ec != std::errc() || res.ptr == fim) {
+                p.erro = true;
+                break;
+            }
+            w = res.ptr;
+            *w++ = '\n';
+        }
+        p.csv.resize(w - p.csv.data());
+    }
+    if (bin) {
+        if (tipo == LEITURA_DOUBLE) {
+            p.bin.resize(len * sizeof(double));
+            std::memcpy(p.bin.data(), p.valores.data(), p.bin.size());
+        } else {
+            p.bin.resize(len * sizeof(int16_t));
+            int16_t* c = reinterpret_cast<int16_t*>(p.bin.data());
+            for (size_t k = 0; k < len; k++) c[k] = paraCenti(p.valores[k]);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Parâmetros do arquivo e dos dados
+    std::string base = "temperaturas";
+    ConfigGerador cfg;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    bool gravarCSV = true;
+    bool gravarBinario = false;
+    TipoLeitura tipoBinario = LEITURA_DOUBLE;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--bin") { gravarBinario = true; tipoBinario = LEITURA_DOUBLE; }
+        else if (arg == "--bin16") { gravarBinario = true; tipoBinario = LEITURA_CENTI16; }
+        else if (arg == "--sem-csv") gravarCSV = false;
+        else if (arg == "--n" && temValor) cfg.n = (uint64_t)std::stod(argv[++i]);
+        else if (arg == "--seed" && temValor) cfg.semente = std::stoull(argv[++i]);
+        else if (arg == "--min" && temValor) cfg.minV = std::stod(argv[++i]);
+        else if (arg == "--max" && temValor) cfg.maxV = std::stod(argv[++i]);
+        else if (arg == "--threads" && temValor) threads = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--saida" && temValor) base = argv[++i];
+        else if (arg == "--dist" && temValor) {
+            if (!distribuicaoPorNome(argv[++i], cfg.dist)) {
+                std::cerr << "Distribuicao desconhecida: " << argv[i] << " (use " << nomesDistribuicoes() << ")" << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Opcao desconhecida: " << arg << std::endl;
+            std::cerr << "Uso: ./gerar [--n N] [--dist D] [--seed S] [--min A] [--max B] [--threads T]"
+                      << " [--saida base] [--bin | --bin16] [--sem-csv]" << std::endl;
+            return 1;
+        }
+    }
+    if (!gravarCSV && !gravarBinario) {
+        std::cerr << "Nada pra gravar: --sem-csv precisa de --bin ou --bin16" << std::endl;
+        return 1;
+    }
+    if (cfg.minV > cfg.maxV) std::swap(cfg.minV, cfg.maxV);
+    if (tipoBinario == LEITURA_CENTI16 && (cfg.minV < -327.68 || cfg.maxV > 327.67)) {
+        std::cerr << "Faixa nao cabe em int16 centesimos (use --bin)" << std::endl;
         return 1;
     }
 
-    // Gerador de números aleatórios
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(temp_min, temp_max);
+    const std::string nome_arquivo = base + ".csv";
+    const std::string nome_binario = base + ".bin";
+
+    // Abre os arquivos pra escrever
+    std::ofstream arquivo, binario;
+    if (gravarCSV) {
+        arquivo.open(nome_arquivo, std::ios::binary);
+        if (!arquivo.is_open()) {
+            std::cerr << "Erro ao criar o arquivo " << nome_arquivo << "!" << std::endl;
+            return 1;
+        }
+    }
+    if (gravarBinario) {
+        binario.open(nome_binario, std::ios::binary);
+        if (!binario.is_open()) {
+            std::cerr << "Erro ao criar o arquivo " << nome_binario << "!" << std::endl;
+            return 1;
+        }
+        CabecalhoLeituras cab = montarCabecalho(cfg.n, tipoBinario);
+        binario.write(reinterpret_cast<const char*>(&cab), sizeof(cab));
+    }
+
+    GeradorLeituras gerador(cfg);
+    const size_t largura = larguraLinha(cfg.minV, cfg.maxV);
+    auto inicio = std::chrono::steady_clock::now();
+
+    // Cada rodada: cada thread gera e formata 1M leituras; enquanto a rodada seguinte
+    // é produzida, a thread principal grava a anterior em ordem.
+    const uint64_t porThread = 16 * GeradorLeituras::BLOCO;
+    const uint64_t porRodada = porThread * threads;
+    std::vector<Pedaco> atual(threads), proximo(threads);
+    std::vector<std::thread> trabalhando;
 
-    // Deixa com 2 casas decimais
-    arquivo << std::fixed << std::setprecision(2);
+    auto disparar = [&](uint64_t ini, std::vector<Pedaco>& pedacos) {
+        for (unsigned t = 0; t < threads; t++) {
+            uint64_t de = ini + t * porThread;
+            size_t len = (de < cfg.n) ? (size_t)std::min<uint64_t>(porThread, cfg.n - de) : 0;
+            trabalhando.emplace_back([&, de, len, t] {
+                produzirPedaco(gerador, de, len, gravarCSV, largura, gravarBinario, tipoBinario, pedacos[t]);
+            });
+        }
+    };
+    auto esperar = [&] {
+        for (auto& t : trabalhando) t.join();
+        trabalhando.clear();
+    };
 
-    // Gera e escreve os dados
-    for (int i = 0; i < qtd_dados; ++i) {
-        double temperatura = dis(gen);
-        arquivo << temperatura << "\n";
+    uint64_t bytesCSV = 0;
+    int ultimoAviso = 0;
+    disparar(0, atual);
+    esperar();
+    for (uint64_t ini = 0; ini < cfg.n; ini += porRodada) {
+        if (ini + porRodada < cfg.n) disparar(ini + porRodada, proximo);
+        for (Pedaco& p : atual) {
+            if (p.erro) {
+                esperar();
+                std::cerr << "Erro ao formatar o CSV: valor fora da largura prevista" << std::endl;
+                return 1;
+            }
+            if (gravarCSV) { arquivo.write(p.csv.data(), p.csv.size()); bytesCSV += p.csv.size(); }
+            if (gravarBinario) binario.write(p.bin.data(), p.bin.size());
+        }
+        esperar();
+        std::swap(atual, proximo);
+
+        // Progresso de 10 em 10% pros arquivos grandes
+        int pct = (int)(100.0 * std::min(ini + porRodada, cfg.n) / cfg.n);
+        if (cfg.n >= 10000000 && pct / 10 > ultimoAviso / 10) {
+            ultimoAviso = pct;
+            std::cerr << "  " << pct << "%" << std::endl;
+        }
     }
 
     arquivo.close();
+    binario.close();
+    if ((gravarCSV && arquivo.fail()) || (gravarBinario && binario.fail())) {
+        std::cerr << "Erro ao gravar (disco cheio?)" << std::endl;
+        return 1;
+    }
+    std::chrono::duration<double> tempo = std::chrono::steady_clock::now() - inicio;
 
-    std::cout << "Arquivo '" << nome_arquivo 
-            << "' criado com " << qtd_dados << " temperaturas." << std::endl;
+    std::string nomeDist;
+    for (const InfoDistribuicao& info : DISTRIBUICOES) if (info.tipo == cfg.dist) nomeDist = info.nome;
+    if (gravarCSV) {
+        std::cout << "Arquivo '" << nome_arquivo
+                << "' criado com " << cfg.n << " temperaturas." << std::endl;
+    }
+    if (gravarBinario) {
+        std::cout << "Arquivo '" << nome_binario << "' criado ("
+                  << (tipoBinario == LEITURA_DOUBLE ? "double" : "int16 centesimos") << ")." << std::endl;
+    }
+    std::cout << "Distribuicao " << nomeDist << ", semente " << cfg.semente << ", " << threads << " thread(s), "
+              << tempo.count() << " s";
+    if (gravarCSV && tempo.count() > 0) std::cout << " (" << bytesCSV / tempo.count() / (1024 * 1024) << " MB/s de CSV)";
+    std::cout << std::endl;
 
     return 0;
-}
\ No newline at end of file
+}
@@ -5,143 +5,62 @@
 #include <fstream>
 #include <chrono>
 #include <iomanip>
+#include <limits>
+#include <random>
+#include <string>
 
-// Heap mínimo simples
-class PureMinHeap {
-private:
-    std::vector<double> heap;
-
-    int parent(int i) { return (i - 1) / 2; }
-    int leftChild(int i) { return (2 * i + 1); }
-    int rightChild(int i) { return (2 * i + 2); }
-
-    // Sobe o elemento até o lugar certo
-    void siftUp(int i) {
-        while (i > 0 && heap[parent(i)] > heap[i]) {
-            std::swap(heap[i], heap[parent(i)]);
-            i = parent(i);
-        }
-    }
-
-    // Desce o elemento até o lugar certo
-    void siftDown(int i) {
-        int minIndex = i;
-        int l = leftChild(i);
-        int r = rightChild(i);
-        int n = heap.size();
-
-        if (l < n && heap[l] < heap[minIndex]) minIndex = l;
-        if (r < n && heap[r] < heap[minIndex]) minIndex = r;
-
-        if (i != minIndex) {
-            std::swap(heap[i], heap[minIndex]);
-            siftDown(minIndex);
-        }
-    }
-
-public:
-    // Adiciona valor no heap
-    void insert(double value) {
-        heap.push_back(value);
-        siftUp(heap.size() - 1);
-    }
-
-    // Remove valor do heap (busca linear)
-    void remove(double value) {
-        int index = -1;
-        // Busca linear O(N) - não é eficiente
-        for (size_t i = 0; i < heap.size(); i++) {
-            if (heap[i] == value) {
-                index = i;
-                break;
-            }
-        }
-        if (index == -1) return;
-
-        heap[index] = heap.back();
-        heap.pop_back();
-
-        if (index < (int)heap.size()) {
-            siftDown(index);
-            siftUp(index);
-        }
-    }
+#include "leituras_bin.hpp"
+#include "indices.hpp"
 
-    // Gera uma cópia ordenada do heap
-    std::vector<double> getSortedCopy() {
-        std::vector<double> temp = heap;
-        std::sort(temp.begin(), temp.end());
-        return temp;
-    }
-
-    // Calcula a mediana
-    double median() {
-        if (heap.empty()) return 0.0;
-        std::vector<double> temp = getSortedCopy(); // Custo alto: Sort
-        int n = temp.size();
-        if (n % 2 != 0) return temp[n / 2];
-        else return (temp[n / 2 - 1] + temp[n / 2]) / 2.0;
-    }
+// Ciclo de ingestão + consulta com Aridade filhos por nó: chega um lote grande, o heap é
+// montado (N inserções ou buildFrom) e depois saem os `consultas` menores com pop()
+template <int Aridade>
+void medirAridade(const std::string& nome, const std::vector<double>& lote, int consultas) {
+    PureMinHeap<double, std::less<double>, Aridade> umPorUm, floyd;
 
-    // Retorna os n menores valores
-    std::vector<double> min(int n) {
-        std::vector<double> temp = getSortedCopy();
-        std::vector<double> result;
-        for(int i=0; i<n && i<(int)temp.size(); i++) result.push_back(temp[i]);
-        return result;
-    }
+    auto start = std::chrono::high_resolution_clock::now();
+    for (double v : lote) umPorUm.insert(v);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_ins = end - start;
 
-    // Retorna os n maiores valores
-    std::vector<double> max(int n) {
-        std::vector<double> temp = getSortedCopy();
-        std::vector<double> result;
-        for(int i=0; i<n && i<(int)temp.size(); i++) 
-            result.push_back(temp[temp.size() - 1 - i]);
-        return result;
-    }
+    start = std::chrono::high_resolution_clock::now();
+    floyd.buildFrom(lote);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_build = end - start;
 
-    // Busca todos os valores no intervalo [x, y]
-    std::vector<double> rangeQuery(double x, double y) {
-        std::vector<double> result;
-        for (double val : heap) {
-            if (val >= x && val <= y) result.push_back(val);
-        }
-        std::sort(result.begin(), result.end()); // Só pra ficar bonitinho
-        return result;
-    }
+    double soma = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < consultas; i++) { soma += floyd.top(); floyd.pop(); }
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_pop = end - start;
 
-    // Verifica se o heap está vazio
-    bool isEmpty() { return heap.empty(); }
-};
+    std::cout << "[ARIDADE " << Aridade << ", " << nome << "] insert 1 a 1: " << t_ins.count() << " ms | buildFrom: "
+              << t_build.count() << " ms | " << consultas << " pops: " << t_pop.count() << " ms"
+              << " | ciclo: " << t_ins.count() + t_pop.count() << " -> " << t_build.count() + t_pop.count()
+              << " ms (soma " << soma << ")" << std::endl;
+}
 
 int main() {
     PureMinHeap sensor;
-    std::string filename = "temperaturas.csv";
-    std::ifstream file(filename);
-    std::string line;
-    int count = 0;
-
-    if (!file.is_open()) {
-        std::cerr << "Erro ao abrir " << filename << std::endl;
+    PureMinHeap live(true); // mesma heap, mas com mediana em streaming
+    // temperaturas.bin mapeado (sem parse) se existir, senão temperaturas.csv
+    Dataset ds = carregarLeituras("temperaturas");
+    VisaoLeituras valores = ds.valores;
+    if (valores.empty()) {
+        std::cerr << "Nenhuma temperatura em temperaturas.bin/.csv" << std::endl;
         return 1;
     }
+    int count = valores.size();
 
     std::cout << std::fixed << std::setprecision(5);
     std::cout << "=== BENCHMARK: MIN HEAP ===" << std::endl;
 
     // 1. Inserção dos dados
     auto start = std::chrono::high_resolution_clock::now();
-    while (std::getline(file, line)) {
-        try {
-            if (!line.empty() && line.back() == '\r') line.pop_back();
-            sensor.insert(std::stod(line));
-            count++;
-        } catch (...) {}
-    }
+    for (double v : valores) sensor.insert(v);
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> t_insert = end - start;
     std::cout << "[INSERT] " << count << " registros | Tempo: " << t_insert.count() << " ms" << std::endl;
-    file.close();
 
     if (sensor.isEmpty()) return 0;
 
@@ -152,6 +71,18 @@ int main() {
     std::chrono::duration<double, std::milli> t_median = end - start;
     std::cout << "[MEDIAN] Resultado: " << med << " | Tempo: " << t_median.count() << " ms" << std::endl;
 
+    // 2b. Mediana em streaming (max-heap + min-heap)
+    start = std::chrono::high_resolution_clock::now();
+    for (double v : valores) live.insert(v);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_live_ins = end - start;
+    start = std::chrono::high_resolution_clock::now();
+    double medLive = live.median();
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_live_med = end - start;
+    std::cout << "[MEDIAN STREAM] Resultado: " << medLive << " | Insert: " << t_live_ins.count()
+              << " ms | Consulta: " << t_live_med.count() << " ms" << std::endl;
+
     // 3. Menores valores (3 menores)
     start = std::chrono::high_resolution_clock::now();
     std::vector<double> mins = sensor.min(3);
@@ -184,6 +115,24 @@ int main() {
     std::chrono::duration<double, std::milli> t_remove = end - start;
     std::cout << "[REMOVE(22.5)] Tempo: " << t_remove.count() << " ms" << std::endl;
 
+    // 6b. Retenção: remove metade das leituras (busca linear x heap indexada)
+    PureMinHeap scanHeap;
+    IndexedMinHeap idxHeap;
+    for (double v : valores) { scanHeap.insert(v); idxHeap.insert(v); }
+    size_t metade = valores.size() / 2;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < metade; i++) scanHeap.remove(valores[i]);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_rem_scan = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < metade; i++) idxHeap.remove(valores[i]);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_rem_idx = end - start;
+    std::cout << "[REMOVE " << metade << "x] Scan: " << t_rem_scan.count()
+              << " ms | Indexada: " << t_rem_idx.count() << " ms" << std::endl;
+
     // 7. Gera lista ordenada (simula print)
     start = std::chrono::high_resolution_clock::now();
     std::vector<double> sortedList = sensor.getSortedCopy();
@@ -191,5 +140,20 @@ int main() {
     std::chrono::duration<double, std::milli> t_sort = end - start;
     std::cout << "[PRINTSORTED] Gerada lista de " << sortedList.size() << " itens | Tempo: " << t_sort.count() << " ms" << std::endl;
 
+    // 8. Aridade do heap e montagem em lote (Floyd) num lote grande
+    const int N = 10000000;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dis(-1000, 4500); // centésimos de grau
+    std::vector<double> lote(N);
+    for (double& v : lote) v = dis(gen) / 100.0;
+    medirAridade<2>("aleatorio", lote, N / 10);
+    medirAridade<4>("aleatorio", lote, N / 10);
+    medirAridade<8>("aleatorio", lote, N / 10);
+    // Lote em ordem decrescente: pior caso da inserção (todo valor sobe até a raiz)
+    std::sort(lote.begin(), lote.end(), std::greater<double>());
+    medirAridade<2>("decrescente", lote, N / 10);
+    medirAridade<4>("decrescente", lote, N / 10);
+    medirAridade<8>("decrescente", lote, N / 10);
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+// Interface comum dos índices de temperatura (AVL, heap, vetor e histograma)
+//
+// Todos são templates no tipo da chave e no comparador:
+//   double  -> padrão, igual ao CSV
+//   float   -> metade da memória nos vetores/heaps
+//   int16_t -> centésimos de grau (22.50 -> 2250), igual ao temperaturas.bin --bin16
+// Mediana, percentil e agregados de intervalo sempre saem em double (na unidade da chave).
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "filtro_simd.hpp"
+
+// O que todo índice tem que ter pra entrar nos benchmarks
+template <typename T>
+concept TemperatureIndex = requires(T idx, typename T::key_type k, int n) {
+    idx.insert(k);
+    idx.remove(k);
+    { idx.median() } -> std::convertible_to<double>;
+    { idx.rangeQuery(k, k) } -> std::same_as<std::vector<typename T::key_type>>;
+    { idx.min(n) } -> std::same_as<std::vector<typename T::key_type>>;
+    { idx.max(n) } -> std::same_as<std::vector<typename T::key_type>>;
+    { idx.count() } -> std::convertible_to<size_t>;
+    { idx.isEmpty() } -> std::convertible_to<bool>;
+};
+
+// Índice que sabe contar e escolher por posição (AVLTree, FenwickHistogram):
+// é o que SensorStore e JanelaDeslizante precisam
+template <typename T>
+concept IndiceOrdenado = TemperatureIndex<T> && requires(T idx, typename T::key_type k, int n) {
+    { idx.select(n) } -> std::convertible_to<typename T::key_type>;
+    { idx.rank(k) } -> std::convertible_to<int>;
+    { idx.rangeCount(k, k) } -> std::convertible_to<int>;
+    idx.forEachInRange(k, k, [](typename T::key_type) { return true; });
+};
+
+// v está em [lo, hi] segundo o comparador
+template <typename Key, typename Compare>
+inline bool dentroDoIntervalo(const Compare& comp, const Key& v, const Key& lo, const Key& hi) {
+    return !comp(v, lo) && !comp(hi, v);
+}
+
+// Os filtros de filtro_simd.hpp só servem pra double em ordem crescente
+template <typename Key, typename Compare>
+inline constexpr bool usaFiltroSIMD = std::is_same_v<Key, double> && std::is_same_v<Compare, std::less<double>>;
+
+// Conta quantos valores de v[0, n) estão em [lo, hi] sem alocar nada.
+// Com double usa o filtro SIMD; com os outros tipos, um laço sem desvio.
+template <typename Key, typename Compare>
+inline size_t contarNoIntervalo(const Compare& comp, const Key* v, size_t n, const Key& lo, const Key& hi) {
+    if constexpr (usaFiltroSIMD<Key, Compare>) {
+        return contarIntervalo(v, n, lo, hi);
+    } else {
+        size_t c = 0;
+        for (size_t i = 0; i < n; i++) c += !comp(v[i], lo) & !comp(hi, v[i]);
+        return c;
+    }
+}
+
+// Copia os valores de v[0, n) que estão em [lo, hi] (na ordem do array): conta primeiro e aloca uma vez só
+template <typename Key, typename Compare>
+inline std::vector<Key> filtrarNoIntervalo(const Compare& comp, const Key* v, size_t n, const Key& lo, const Key& hi) {
+    if constexpr (usaFiltroSIMD<Key, Compare>) {
+        std::vector<double> result(contarIntervalo(v, n, lo, hi) + FILTRO_FOLGA);
+        result.resize(filtrarIntervalo(v, n, lo, hi, result.data()));
+        return result;
+    } else {
+        std::vector<Key> result;
+        result.reserve(contarNoIntervalo(comp, v, n, lo, hi));
+        for (size_t i = 0; i < n; i++) {
+            if (dentroDoIntervalo(comp, v[i], lo, hi)) result.push_back(v[i]);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,45 @@
+// Biblioteca dos índices (só headers): inclui tudo de uma vez
+//
+//   AVLTree<Key, Compare>, PooledAVLTree<Key, Compare>   -> avl_tree.hpp
+//   CountedAVLTree<Key, Compare> (repetidos no contador)  -> avl_tree.hpp
+//   PureMinHeap<Key, Compare>, IndexedMinHeap<...>        -> min_heap.hpp
+//   VectorInsertionSort<Key, Compare>                     -> vector_insertion_sort.hpp
+//   FenwickHistogram<Key>                                 -> fenwick_histogram.hpp
+//   SensorStore<Indice> (um índice por sensor)            -> sensor_store.hpp
+//   ConcurrentAVLTree<Key, Compare> (várias threads)      -> concurrent_avl.hpp
+//   JanelaDeslizante<Indice> (só as leituras recentes)    -> janela_deslizante.hpp
+//   EytzingerSnapshot<Key, Compare> (só leitura)          -> snapshot_estatico.hpp
+//
+// Sem argumento de template é tudo double em ordem crescente, igual antes:
+//   AVLTree<> avl;  PureMinHeap heap;  AVLTree<float> avlFloat;
+#pragma once
+
+#include <cstdint>
+
+#include "indice.hpp"
+#include "avl_tree.hpp"
+#include "min_heap.hpp"
+#include "vector_insertion_sort.hpp"
+#include "fenwick_histogram.hpp"
+#include "sensor_store.hpp"
+#include "concurrent_avl.hpp"
+#include "janela_deslizante.hpp"
+#include "snapshot_estatico.hpp"
+
+// Confere na compilação que todo índice segue a mesma interface nos três tipos de chave
+#define CONFERE_INDICE(T) \
+    static_assert(TemperatureIndex<T<double>>, #T "<double> nao segue TemperatureIndex"); \
+    static_assert(TemperatureIndex<T<float>>, #T "<float> nao segue TemperatureIndex"); \
+    static_assert(TemperatureIndex<T<int16_t>>, #T "<int16_t> nao segue TemperatureIndex");
+
+CONFERE_INDICE(AVLTree)
+CONFERE_INDICE(PooledAVLTree)
+CONFERE_INDICE(CountedAVLTree)
+CONFERE_INDICE(PureMinHeap)
+CONFERE_INDICE(VectorInsertionSort)
+CONFERE_INDICE(FenwickHistogram)
+CONFERE_INDICE(ConcurrentAVLTree)
+
+#undef CONFERE_INDICE
+
+static_assert(IndiceOrdenado<AVLTree<>> && IndiceOrdenado<CountedAVLTree<>> && IndiceOrdenado<FenwickHistogram<>>, "SensorStore precisa de select/rank");
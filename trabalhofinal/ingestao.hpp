@@ -0,0 +1,240 @@
+// Ingestão com várias threads produtoras e uma só aplicando nos índices
+//
+// Em vez de cada leitura travar o índice (um lock por leitura), as produtoras só publicam
+// num anel sem trava e uma thread aplicadora drena o anel em lotes: ordena o lote (com o
+// comparador do índice) e junta no índice de uma vez (insertBatch quando o índice tem, que
+// vê o lote já ordenado e não ordena de novo; senão insere em ordem).
+// O índice só é travado uma vez por lote, então consultas de outras threads (consultar())
+// disputam a trava bem menos.
+//
+//   AVLTree<> avl;
+//   IngestorLotes ing(avl);              // sobe a thread aplicadora
+//   ing.publicar(22.5);                  // de qualquer thread
+//   ing.consultar([](auto& idx) { return idx.median(); });
+//   ing.encerrar();                      // aplica o que falta e para a thread
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <cstdint>
+
+// Anel limitado sem trava, várias produtoras e uma consumidora.
+// Cada célula tem um número de sequência (esquema do Vyukov): a produtora reserva a posição
+// com um CAS na cauda, escreve o valor e publica a sequência; a consumidora lê em ordem.
+template <typename T>
+class AnelMPSC {
+private:
+    struct Celula {
+        std::atomic<size_t> seq;
+        T valor;
+    };
+
+    std::unique_ptr<Celula[]> celulas;
+    size_t mascara;
+    alignas(64) std::atomic<size_t> cauda{0}; // próxima posição das produtoras
+    alignas(64) size_t cabeca = 0;            // próxima posição da consumidora (só ela mexe)
+
+public:
+    // Capacidade arredondada pra cima pra potência de 2
+    explicit AnelMPSC(size_t capacidade) {
+        size_t cap = 2;
+        while (cap < capacidade) cap *= 2;
+        mascara = cap - 1;
+        celulas = std::make_unique<Celula[]>(cap);
+        for (size_t i = 0; i < cap; i++) celulas[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    size_t capacidade() const { return mascara + 1; }
+
+    // Qualquer thread. Retorna false se o anel estiver cheio.
+    bool tentarPublicar(const T& v) {
+        size_t pos = cauda.load(std::memory_order_relaxed);
+        while (true) {
+            Celula& c = celulas[pos & mascara];
+            size_t seq = c.seq.load(std::memory_order_acquire);
+            intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+            if (dif == 0) {
+                if (cauda.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.valor = v;
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                return false; // a consumidora ainda não liberou essa célula: cheio
+            } else {
+                pos = cauda.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Só a consumidora. Copia até `max` valores prontos pra `out` e devolve quantos.
+    // Para no primeiro que ainda está sendo escrito (a ordem de publicação é mantida).
+    size_t drenar(T* out, size_t max) {
+        size_t n = 0;
+        while (n < max) {
+            Celula& c = celulas[cabeca & mascara];
+            if (c.seq.load(std::memory_order_acquire) != cabeca + 1) break;
+            out[n++] = c.valor;
+            c.seq.store(cabeca + mascara + 1, std::memory_order_release);
+            cabeca++;
+        }
+        return n;
+    }
+};
+
+// O que fazer quando o anel enche
+enum class Contrapressao {
+    Esperar,   // a produtora espera (cede a CPU) até abrir espaço: nada se perde
+    Descartar, // publicar() devolve false e a leitura é contada em descartados()
+};
+
+struct ConfigIngestao {
+    size_t capacidade = 1 << 16;   // posições do anel
+    size_t loteMax = 4096;         // maior lote aplicado de uma vez
+    Contrapressao cheio = Contrapressao::Esperar;
+    int amostraLatencia = 16;      // guarda a latência de 1 a cada N leituras (0 = não mede)
+    int ociosoUs = 50;             // quanto a aplicadora dorme quando o anel fica vazio
+};
+
+// Comparador do índice (key_compare), ou std::less se o índice não disser
+template <typename Indice>
+struct ComparadorDoIndice { using tipo = std::less<typename Indice::key_type>; };
+template <typename Indice> requires requires { typename Indice::key_compare; }
+struct ComparadorDoIndice<Indice> { using tipo = typename Indice::key_compare; };
+
+template <typename Indice>
+class IngestorLotes {
+public:
+    using key_type = typename Indice::key_type;
+
+private:
+    using Relogio = std::chrono::steady_clock;
+
+    struct Entrada {
+        key_type valor;
+        int64_t publicadoNs; // quando a produtora publicou (pra medir a latência até aplicar)
+    };
+
+    Indice& indice;
+    ConfigIngestao cfg;
+    std::mutex travaIndice;      // a aplicadora segura durante um lote; consultar() também
+    AnelMPSC<Entrada> anel;
+    std::atomic<bool> parar{false};
+    std::atomic<uint64_t> publicadas{0}, aplicadas{0}, descartadas{0}, esperas{0}, lotes{0};
+    std::vector<double> latencias; // ns da publicação até o lote estar no índice (só a aplicadora mexe)
+    std::thread aplicadora;
+
+    static int64_t agoraNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Relogio::now().time_since_epoch()).count();
+    }
+
+    void aplicar(std::vector<Entrada>& buf, size_t n, std::vector<key_type>& lote) {
+        lote.resize(n);
+        for (size_t i = 0; i < n; i++) lote[i] = buf[i].valor;
+        std::sort(lote.begin(), lote.end(), typename ComparadorDoIndice<Indice>::tipo());
+        {
+            std::lock_guard lock(travaIndice);
+            if constexpr (requires { indice.insertBatch(std::span<const key_type>(lote)); }) {
+                indice.insertBatch(std::span<const key_type>(lote));
+            } else {
+                for (key_type v : lote) indice.insert(v);
+            }
+        }
+        if (cfg.amostraLatencia > 0) {
+            int64_t agora = agoraNs();
+            uint64_t base = aplicadas.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < n; i++) {
+                if ((base + i) % cfg.amostraLatencia == 0) latencias.push_back((double)(agora - buf[i].publicadoNs));
+            }
+        }
+        aplicadas.fetch_add(n, std::memory_order_release);
+        lotes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void laco() {
+        std::vector<Entrada> buf(cfg.loteMax);
+        std::vector<key_type> lote;
+        lote.reserve(cfg.loteMax);
+        int vazias = 0;
+        while (true) {
+            size_t n = anel.drenar(buf.data(), buf.size());
+            if (n > 0) {
+                aplicar(buf, n, lote);
+                vazias = 0;
+                continue;
+            }
+            // Vazio: só sai quando pediram pra parar e nenhuma produtora ficou no meio
+            if (parar.load() && aplicadas.load() + descartadas.load() == publicadas.load()) break;
+            if (++vazias < 64) std::this_thread::yield();
+            else std::this_thread::sleep_for(std::chrono::microseconds(cfg.ociosoUs));
+        }
+    }
+
+public:
+    explicit IngestorLotes(Indice& idx, ConfigIngestao c = {})
+        : indice(idx), cfg(c), anel(c.capacidade) {
+        cfg.loteMax = std::max<size_t>(1, cfg.loteMax);
+        aplicadora = std::thread([this] { laco(); });
+    }
+    ~IngestorLotes() { encerrar(); }
+    IngestorLotes(const IngestorLotes&) = delete;
+    IngestorLotes& operator=(const IngestorLotes&) = delete;
+
+    // Qualquer thread. Com Contrapressao::Descartar devolve false quando o anel está cheio.
+    // Depois de encerrar() devolve false (e conta como descartada) em vez de ficar esperando
+    // um anel que ninguém mais drena. Conta a publicação antes de olhar `parar` (as duas seq_cst):
+    // ou ela vê o pedido de parada, ou a aplicadora vê a publicação e só sai depois de aplicá-la.
+    bool publicar(key_type valor) {
+        publicadas.fetch_add(1);
+        if (parar.load()) {
+            descartadas.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        Entrada e{valor, cfg.amostraLatencia > 0 ? agoraNs() : 0};
+        if (anel.tentarPublicar(e)) return true;
+        if (cfg.cheio == Contrapressao::Descartar) {
+            descartadas.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        esperas.fetch_add(1, std::memory_order_relaxed);
+        while (!anel.tentarPublicar(e)) std::this_thread::yield();
+        return true;
+    }
+
+    // Roda f(indice) com o índice travado (entre dois lotes)
+    template <typename F>
+    auto consultar(F&& f) {
+        std::lock_guard lock(travaIndice);
+        return f(indice);
+    }
+
+    // Espera até tudo que já foi publicado estar no índice
+    void esperarAplicar() {
+        while (aplicadas.load(std::memory_order_acquire) + descartadas.load() < publicadas.load()) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Aplica o que falta e para a aplicadora (depois disso publicar() devolve false)
+    void encerrar() {
+        if (!aplicadora.joinable()) return;
+        parar.store(true);
+        aplicadora.join();
+    }
+
+    uint64_t totalPublicadas() const { return publicadas.load(); }
+    uint64_t totalAplicadas() const { return aplicadas.load(); }
+    uint64_t descartados() const { return descartadas.load(); }
+    uint64_t vezesCheio() const { return esperas.load(); } // publicações que tiveram que esperar
+    uint64_t totalLotes() const { return lotes.load(); }
+
+    // Latências amostradas em ns (ler só depois de encerrar())
+    const std::vector<double>& latenciasNs() const { return latencias; }
+};
@@ -0,0 +1,182 @@
+// Bibliotecas que vou usar
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <iomanip>
+#include <sstream>
+#include <cmath>
+
+#include "indices.hpp"
+#include "ingestao.hpp"
+#include "medicao.hpp"
+
+// Uso: ./ingestao [opções]
+//   --leituras N      leituras no total, divididas entre as produtoras (padrão 2000000)
+//   --produtoras P    varre 1, 2, 4, ... até P threads produtoras (padrão 8)
+//   --anel C          posições do anel (padrão 65536)
+//   --lote L          maior lote aplicado de uma vez (padrão 4096)
+//   --descartar       anel cheio descarta a leitura em vez de esperar
+//   --taxa R          leituras/s somando as produtoras (padrão 0 = o mais rápido possível).
+//                     Sem taxa o anel vive cheio e a latência é quase toda fila; com uma taxa
+//                     sustentável ela mostra só o custo de juntar em lotes
+//
+// Pra AVLTree e PureMinHeap compara:
+//   direto    cada produtora trava um mutex e chama insert (latência = a chamada, com a espera)
+//   anel      cada produtora publica no anel; uma thread aplica em lotes ordenados
+//             (latência = da publicação até o lote estar no índice)
+// Vazão = leituras / tempo até a última estar no índice.
+
+struct OpcoesIngestao {
+    int leituras = 2000000;
+    int maxProdutoras = 8;
+    double taxa = 0;
+    ConfigIngestao cfg;
+};
+
+struct ResultadoIngestao {
+    double mlps = 0;        // milhões de leituras por segundo
+    Estatisticas lat;       // ns
+    uint64_t descartadas = 0;
+    uint64_t lotes = 0;
+};
+
+// Leituras de cada produtora sorteadas antes (não mede o gerador)
+std::vector<std::vector<double>> sortearLeituras(int total, int P) {
+    std::vector<std::vector<double>> v(P);
+    for (int p = 0; p < P; p++) {
+        std::mt19937 gen(100 + p);
+        std::uniform_real_distribution<> dis(-10.0, 45.0);
+        v[p].resize(total / P + (p < total % P));
+        for (double& x : v[p]) x = std::round(dis(gen) * 100.0) / 100.0;
+    }
+    return v;
+}
+
+// Segura a produtora no ritmo de `taxa` leituras/s (confere o relógio a cada 64 leituras)
+struct Ritmo {
+    double nsPorLeitura = 0;
+    RelogioMedicao::time_point inicio = RelogioMedicao::now();
+    void esperar(size_t i) {
+        if (nsPorLeitura <= 0 || i % 64 != 0) return;
+        auto alvo = inicio + std::chrono::nanoseconds((long long)(i * nsPorLeitura));
+        while (RelogioMedicao::now() < alvo) std::this_thread::yield();
+    }
+};
+
+// Sobe as P produtoras, solta todas juntas e espera terminar; devolve o tempo em ns
+template <typename F>
+double rodarProdutoras(int P, F&& produzir) {
+    std::atomic<int> prontas{0};
+    std::atomic<bool> largar{false};
+    std::vector<std::thread> ts;
+    for (int p = 0; p < P; p++) {
+        ts.emplace_back([&, p] {
+            prontas++;
+            while (!largar.load(std::memory_order_acquire)) std::this_thread::yield();
+            produzir(p);
+        });
+    }
+    while (prontas.load() < P) std::this_thread::yield();
+    return cronometrar([&] {
+        largar.store(true, std::memory_order_release);
+        for (auto& t : ts) t.join();
+    });
+}
+
+template <typename Indice>
+ResultadoIngestao direto(const std::vector<std::vector<double>>& dados, double taxa) {
+    Indice idx;
+    std::mutex trava;
+    int P = dados.size();
+    std::vector<std::vector<double>> lat(P);
+    double ns = rodarProdutoras(P, [&](int p) {
+        lat[p].reserve(dados[p].size() / 16 + 1);
+        Ritmo ritmo{taxa > 0 ? 1e9 * P / taxa : 0};
+        for (size_t i = 0; i < dados[p].size(); i++) {
+            ritmo.esperar(i);
+            if (i % 16 == 0) {
+                lat[p].push_back(cronometrar([&] { std::lock_guard lock(trava); idx.insert(dados[p][i]); }));
+            } else {
+                std::lock_guard lock(trava);
+                idx.insert(dados[p][i]);
+            }
+        }
+    });
+    std::vector<double> todas;
+    for (auto& l : lat) todas.insert(todas.end(), l.begin(), l.end());
+    size_t total = 0;
+    for (auto& d : dados) total += d.size();
+    naoOtimizar(idx.count());
+    return {total / ns * 1000.0, resumir(todas), 0, 0};
+}
+
+template <typename Indice>
+ResultadoIngestao anel(const std::vector<std::vector<double>>& dados, const ConfigIngestao& cfg, double taxa) {
+    Indice idx;
+    IngestorLotes<Indice> ing(idx, cfg);
+    int P = dados.size();
+    double ns = rodarProdutoras(P, [&](int p) {
+        Ritmo ritmo{taxa > 0 ? 1e9 * P / taxa : 0};
+        for (size_t i = 0; i < dados[p].size(); i++) {
+            ritmo.esperar(i);
+            ing.publicar(dados[p][i]);
+        }
+    });
+    // A vazão conta até a última leitura estar no índice
+    ns += cronometrar([&] { ing.esperarAplicar(); });
+    ing.encerrar();
+    naoOtimizar(idx.count());
+    return {ing.totalPublicadas() / ns * 1000.0, resumir(ing.latenciasNs()), ing.descartados(), ing.totalLotes()};
+}
+
+std::string linha(const std::string& nome, const ResultadoIngestao& r) {
+    std::ostringstream s;
+    s << std::left << std::setw(12) << nome << std::right << std::fixed << std::setprecision(2)
+      << std::setw(10) << r.mlps << " M/s" << std::setprecision(1)
+      << std::setw(12) << r.lat.mediana / 1000.0 << std::setw(10) << r.lat.p95 / 1000.0
+      << std::setw(10) << r.lat.p99 / 1000.0;
+    if (r.lotes) s << "   " << r.lotes << " lotes";
+    if (r.descartadas) s << ", " << r.descartadas << " descartadas";
+    return s.str();
+}
+
+template <typename Indice>
+void medirIndice(const std::string& nome, const OpcoesIngestao& op) {
+    std::cout << "\n=== " << nome << " ===\n";
+    std::cout << std::left << std::setw(12) << "P / modo" << std::right << std::setw(14) << "vazao"
+              << std::setw(12) << "p50 us" << std::setw(10) << "p95 us" << std::setw(10) << "p99 us" << "\n";
+    for (int P = 1; P <= op.maxProdutoras; P *= 2) {
+        auto dados = sortearLeituras(op.leituras, P);
+        std::cout << linha(std::to_string(P) + " direto", direto<Indice>(dados, op.taxa)) << "\n";
+        std::cout << linha(std::to_string(P) + " anel", anel<Indice>(dados, op.cfg, op.taxa)) << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    OpcoesIngestao op;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--leituras" && temValor) op.leituras = std::max(1, (int)std::stod(argv[++i]));
+        else if (arg == "--produtoras" && temValor) op.maxProdutoras = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--anel" && temValor) op.cfg.capacidade = std::max(2, std::stoi(argv[++i]));
+        else if (arg == "--lote" && temValor) op.cfg.loteMax = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--descartar") op.cfg.cheio = Contrapressao::Descartar;
+        else if (arg == "--taxa" && temValor) op.taxa = std::stod(argv[++i]);
+        else {
+            std::cerr << "Uso: ./ingestao [--leituras N] [--produtoras P] [--anel C] [--lote L] [--descartar] [--taxa R]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << op.leituras << " leituras | anel " << op.cfg.capacidade << " | lote ate " << op.cfg.loteMax
+              << " | cheio: " << (op.cfg.cheio == Contrapressao::Esperar ? "espera" : "descarta")
+              << " | taxa: " << (op.taxa > 0 ? std::to_string((long)op.taxa) + "/s" : "maxima") << " | nucleos: " << std::thread::hardware_concurrency() << std::endl;
+    medirIndice<AVLTree<>>("AVLTree", op);
+    medirIndice<PureMinHeap<>>("PureMinHeap", op);
+    return 0;
+}
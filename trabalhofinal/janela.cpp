@@ -0,0 +1,113 @@
+// Bibliotecas que vou usar
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <string>
+#include <chrono>   // pra medir tempo
+#include <cstdint>
+
+#include "indices.hpp"
+#include "gerador.hpp"
+#include "medicao.hpp"
+
+// Uso: ./janela [--leituras N] [--janela W] [--idade T] [--consulta C] [--dist D]
+//   N leituras (padrão 1000000), uma por 100 ms, janela de até W leituras (padrão 10000)
+//   e/ou T ms (padrão 0 = sem limite de tempo); a cada C leituras (padrão 100) consulta
+//   mediana, p95 e quantas passaram de 30 graus na janela
+//
+// Compara a janela com AVL, a janela com histograma e o jeito ingênuo (copiar a janela
+// pra um vetor e usar nth_element a cada consulta).
+
+struct Consulta {
+    double mediana, p95;
+    int acima30;
+};
+
+template <typename Indice>
+double rodarJanela(const std::vector<double>& dados, ConfigJanela cfg, int cada, std::vector<Consulta>& saida) {
+    JanelaDeslizante<Indice> janela(cfg);
+    return cronometrar([&] {
+        for (size_t i = 0; i < dados.size(); i++) {
+            janela.insert((int64_t)i * 100, dados[i]);
+            if (i % cada == 0) saida.push_back({janela.median(), janela.percentile(95), janela.rangeCount(30.0, 45.0)});
+        }
+    });
+}
+
+// Mesmo resultado sem índice: a cada consulta copia a janela e seleciona
+double rodarIngenuo(const std::vector<double>& dados, ConfigJanela cfg, int cada, std::vector<Consulta>& saida) {
+    std::deque<std::pair<int64_t, double>> fila;
+    std::vector<double> copia;
+    return cronometrar([&] {
+        for (size_t i = 0; i < dados.size(); i++) {
+            int64_t t = (int64_t)i * 100;
+            fila.push_back({t, dados[i]});
+            if (cfg.maxLeituras > 0 && fila.size() > cfg.maxLeituras) fila.pop_front();
+            while (cfg.maxIdade > 0 && fila.front().first <= t - cfg.maxIdade) fila.pop_front();
+            if (i % cada != 0) continue;
+
+            copia.clear();
+            for (auto& c : fila) copia.push_back(c.second);
+            size_t n = copia.size();
+            auto k = [&](size_t pos) { std::nth_element(copia.begin(), copia.begin() + pos, copia.end()); return copia[pos]; };
+            double mediana = (n % 2) ? k(n / 2) : (k(n / 2 - 1) + k(n / 2)) / 2.0;
+            double pos = 0.95 * (n - 1);
+            size_t lo = (size_t)pos;
+            double p95 = (lo + 1 >= n) ? k(n - 1) : k(lo) * (1.0 - (pos - lo)) + k(lo + 1) * (pos - lo);
+            int acima = (int)std::count_if(copia.begin(), copia.end(), [](double v) { return v >= 30.0; });
+            saida.push_back({mediana, p95, acima});
+        }
+    });
+}
+
+int main(int argc, char* argv[]) {
+    ConfigGerador gen;
+    gen.n = 1000000;
+    gen.dist = Distribuicao::Picos;
+    ConfigJanela cfg{10000, 0};
+    int cada = 100;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--leituras" && temValor) gen.n = (uint64_t)std::stod(argv[++i]);
+        else if (arg == "--janela" && temValor) cfg.maxLeituras = (size_t)std::stod(argv[++i]);
+        else if (arg == "--idade" && temValor) cfg.maxIdade = std::stoll(argv[++i]);
+        else if (arg == "--consulta" && temValor) cada = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--dist" && temValor && distribuicaoPorNome(argv[++i], gen.dist)) {}
+        else {
+            std::cerr << "Uso: ./janela [--leituras N] [--janela W] [--idade T] [--consulta C] [--dist D]" << std::endl;
+            return 1;
+        }
+    }
+    if (cfg.maxLeituras == 0 && cfg.maxIdade == 0) cfg.maxLeituras = 10000;
+
+    std::vector<double> dados = gerarLeituras(gen);
+    std::cout << gen.n << " leituras (uma a cada 100 ms), janela: "
+              << (cfg.maxLeituras ? std::to_string(cfg.maxLeituras) + " leituras" : "sem limite de quantidade")
+              << " / " << (cfg.maxIdade ? std::to_string(cfg.maxIdade) + " ms" : "sem limite de tempo")
+              << ", consulta a cada " << cada << std::endl;
+
+    std::vector<Consulta> avl, hist, ingenuo;
+    double tAvl = rodarJanela<AVLTree<>>(dados, cfg, cada, avl);
+    double tHist = rodarJanela<FenwickHistogram<>>(dados, cfg, cada, hist);
+    double tIng = rodarIngenuo(dados, cfg, cada, ingenuo);
+
+    bool iguais = true;
+    for (size_t i = 0; i < avl.size(); i++) {
+        iguais &= avl[i].mediana == ingenuo[i].mediana && avl[i].acima30 == ingenuo[i].acima30
+               && std::abs(avl[i].p95 - ingenuo[i].p95) < 1e-9
+               && hist[i].mediana == avl[i].mediana && hist[i].acima30 == avl[i].acima30;
+    }
+
+    auto porLeitura = [&](double ns) { return ns / dados.size(); };
+    std::cout << "\nJanela com AVL:         " << tAvl / 1e6 << " ms (" << porLeitura(tAvl) << " ns por leitura)" << std::endl;
+    std::cout << "Janela com histograma:  " << tHist / 1e6 << " ms (" << porLeitura(tHist) << " ns por leitura)" << std::endl;
+    std::cout << "Copiando + nth_element: " << tIng / 1e6 << " ms (" << porLeitura(tIng) << " ns por leitura)" << std::endl;
+    if (!avl.empty()) {
+        std::cout << "\nUltima consulta: mediana " << avl.back().mediana << " | p95 " << avl.back().p95
+                  << " | acima de 30: " << avl.back().acima30 << std::endl;
+    }
+    std::cout << "Resultados " << (iguais ? "iguais" : "DIFERENTES") << " nos tres jeitos" << std::endl;
+    return iguais ? 0 : 1;
+}
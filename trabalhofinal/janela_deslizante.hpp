@@ -0,0 +1,140 @@
+// Estatísticas só das leituras recentes ("mediana dos últimos 60 s / das últimas 10 mil")
+//
+// Guarda as chegadas numa fila (FIFO) e os valores num índice ordenado (AVLTree ou
+// FenwickHistogram). Cada leitura nova entra no índice e as que saem da janela são
+// tiradas pela frente da fila, então insert + expiração custam O(log N) cada
+// (O(log D) no histograma) e não tem remove(valor) com busca linear.
+//
+//   JanelaDeslizante<AVLTree<>> j({10000, 60000});  // até 10 mil leituras e até 60000 ms
+//   j.insert(t, 22.5);      // t sempre crescente (na unidade que quiser; aqui ms)
+//   j.avancar(agora);       // expira por tempo mesmo sem leitura nova
+//   j.median(); j.percentile(95); j.rangeCount(30, 45);
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <cmath>
+#include <type_traits>
+#include <cstdint>
+
+#include "indice.hpp"
+
+struct ConfigJanela {
+    size_t maxLeituras = 0; // 0 = sem limite de quantidade
+    int64_t maxIdade = 0;   // 0 = sem limite de tempo; senão fica só t > agora - maxIdade
+    int escalaMedia = 100;  // unidades por grau da soma da média (100 = centésimos, a mesma do
+                            // histograma); chave inteira já está na unidade dela e ignora isso
+};
+
+template <IndiceOrdenado Indice>
+class JanelaDeslizante {
+public:
+    using key_type = typename Indice::key_type;
+
+private:
+    struct Chegada {
+        int64_t t;
+        key_type valor;
+    };
+
+    ConfigJanela cfg;
+    std::unique_ptr<Indice> indice;
+    std::deque<Chegada> fila;
+    int64_t ultimo = INT64_MIN; // maior timestamp visto
+    // Soma da janela (média em O(1)) em unidades inteiras: somar e subtrair double pra sempre
+    // acumula erro de arredondamento, em inteiro o que sai é exatamente o que entrou
+    int64_t soma = 0;
+
+    int64_t quantizar(key_type v) const {
+        if constexpr (std::is_integral_v<key_type>) return v;
+        else return std::llround((double)v * cfg.escalaMedia);
+    }
+    double escalaSoma() const { return std::is_integral_v<key_type> ? 1.0 : cfg.escalaMedia; }
+
+    void tirarDaFrente() {
+        indice->remove(fila.front().valor);
+        soma -= quantizar(fila.front().valor);
+        fila.pop_front();
+    }
+
+    void expirar() {
+        if (cfg.maxLeituras > 0) {
+            while (fila.size() > cfg.maxLeituras) tirarDaFrente();
+        }
+        if (cfg.maxIdade > 0) {
+            while (!fila.empty() && fila.front().t <= ultimo - cfg.maxIdade) tirarDaFrente();
+        }
+    }
+
+public:
+    explicit JanelaDeslizante(ConfigJanela c = {}, std::unique_ptr<Indice> idx = std::make_unique<Indice>())
+        : cfg(c), indice(std::move(idx)) {}
+
+    // O(log N). Timestamp menor que o último não volta o relógio (a leitura entra com o
+    // próprio t, mas só sai na ordem de chegada). false = o índice recusou o valor (o
+    // histograma recusa fora da faixa): ela não entra na janela, mas o relógio anda.
+    bool insert(int64_t t, key_type valor) {
+        int antes = (int)indice->count();
+        indice->insert(valor);
+        bool entrou = (int)indice->count() != antes;
+        if (entrou) {
+            fila.push_back({t, valor});
+            soma += quantizar(valor);
+        }
+        avancar(t);
+        return entrou;
+    }
+
+    // Expira por tempo sem inserir nada (ex.: sensor ficou mudo)
+    void avancar(int64_t agora) {
+        ultimo = std::max(ultimo, agora);
+        expirar();
+    }
+
+    void clear() {
+        while (!fila.empty()) tirarDaFrente();
+        soma = 0;
+    }
+
+    size_t count() const { return fila.size(); }
+    bool isEmpty() const { return fila.empty(); }
+    int64_t maisAntiga() const { return fila.empty() ? 0 : fila.front().t; }
+    const ConfigJanela& config() const { return cfg; }
+
+    // Índice com o conteúdo da janela (pra usar o resto da API dele; não inserir/remover por fora)
+    Indice& conteudo() { return *indice; }
+
+    // k-ésimo menor da janela (k começa em 0)
+    key_type select(int k) { return indice->select(k); }
+    key_type min() { return indice->select(0); }
+    key_type max() { return indice->select((int)fila.size() - 1); }
+    // Média na resolução de escalaMedia (centésimos por padrão)
+    double mean() const { return fila.empty() ? 0.0 : soma / escalaSoma() / fila.size(); }
+
+    double median() { return indice->median(); }
+
+    // Percentil p (0 a 100), interpolando entre os dois vizinhos: dois select, O(log N)
+    double percentile(double p) {
+        int n = (int)fila.size();
+        if (n == 0) return 0.0;
+        double pos = std::clamp(p, 0.0, 100.0) / 100.0 * (n - 1);
+        int lo = (int)pos;
+        if (lo + 1 >= n) return indice->select(n - 1);
+        double frac = pos - lo;
+        return indice->select(lo) * (1.0 - frac) + indice->select(lo + 1) * frac;
+    }
+
+    int rank(key_type x) { return indice->rank(x); }
+    int rangeCount(key_type x, key_type y) { return indice->rangeCount(x, y); }
+    std::vector<key_type> rangeQuery(key_type x, key_type y) { return indice->rangeQuery(x, y); }
+    std::vector<key_type> min(int n) { return indice->min(n); }
+    std::vector<key_type> max(int n) { return indice->max(n); }
+
+    // As leituras da janela na ordem de chegada (mais antiga primeiro)
+    template <typename F>
+    void forEachChegada(F&& visit) const {
+        for (const Chegada& c : fila) visit(c.t, c.valor);
+    }
+};
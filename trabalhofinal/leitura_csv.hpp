@@ -0,0 +1,106 @@
+// Leitura rápida do CSV de temperaturas (um valor por linha)
+// - mapeia o arquivo na memória (mmap) em vez de ler linha por linha
+// - converte com std::from_chars: sem std::string por linha e sem exceção em linha ruim
+// - arquivos grandes são divididos em pedaços (alinhados no '\n') e lidos em paralelo
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <thread>
+#include <algorithm>
+#include <filesystem>
+#include <cstring>
+
+#include "arquivo_mapeado.hpp"
+
+// Abaixo disso não vale a pena abrir threads
+const size_t CSV_TAMANHO_PARALELO = 8 << 20; // 8 MB
+
+// Converte as linhas de [ini, fim) e joga em out. Retorna quantas linhas foram rejeitadas.
+inline size_t parseTrechoCSV(const char* ini, const char* fim, std::vector<double>& out) {
+    size_t rejeitadas = 0;
+    const char* p = ini;
+    while (p < fim) {
+        const char* nl = static_cast<const char*>(memchr(p, '\n', fim - p));
+        const char* eol = nl ? nl : fim;
+        const char* a = p;
+        const char* b = eol;
+        // Tira espaços e o \r do Windows
+        while (a < b && (*a == ' ' || *a == '\t')) a++;
+        while (b > a && (b[-1] == '\r' || b[-1] == ' ' || b[-1] == '\t')) b--;
+        if (a < b) {
+            if (*a == '+') a++; // from_chars não aceita '+'
+            double v;
+            auto [ptr, ec] = std::from_chars(a, b, v);
+            if (ec == std::errc() && ptr == b) out.push_back(v);
+            else rejeitadas++;
+        }
+        p = eol + 1;
+    }
+    return rejeitadas;
+}
+
+// Divide o texto em pedaços que terminam em '\n' e converte cada um numa thread
+inline std::vector<double> parseTextoCSV(std::string_view texto, size_t* rejeitadas = nullptr) {
+    const char* ini = texto.data();
+    const char* fim = ini + texto.size();
+
+    size_t nThreads = 1;
+    if (texto.size() >= CSV_TAMANHO_PARALELO) {
+        nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Fronteiras dos pedaços: cada uma avança até logo depois de um '\n'
+    std::vector<const char*> cortes{ini};
+    for (size_t i = 1; i < nThreads; i++) {
+        const char* c = ini + texto.size() * i / nThreads;
+        if (c < cortes.back()) c = cortes.back();
+        const char* nl = static_cast<const char*>(memchr(c, '\n', fim - c));
+        cortes.push_back(nl ? nl + 1 : fim);
+    }
+    cortes.push_back(fim);
+
+    size_t pedacos = cortes.size() - 1;
+    std::vector<std::vector<double>> partes(pedacos);
+    std::vector<size_t> ruins(pedacos, 0);
+    for (size_t i = 0; i < pedacos; i++) {
+        // ~6 bytes por linha no CSV gerado
+        partes[i].reserve((cortes[i + 1] - cortes[i]) / 6 + 1);
+    }
+
+    if (pedacos == 1) {
+        ruins[0] = parseTrechoCSV(cortes[0], cortes[1], partes[0]);
+    } else {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < pedacos; i++) {
+            threads.emplace_back([&, i] { ruins[i] = parseTrechoCSV(cortes[i], cortes[i + 1], partes[i]); });
+        }
+        for (auto& t : threads) t.join();
+    }
+
+    // Junta na ordem original do arquivo
+    size_t total = 0, totalRuins = 0;
+    for (size_t i = 0; i < pedacos; i++) { total += partes[i].size(); totalRuins += ruins[i]; }
+    if (rejeitadas) *rejeitadas = totalRuins;
+    if (pedacos == 1) return std::move(partes[0]);
+    std::vector<double> dados;
+    dados.reserve(total);
+    for (auto& parte : partes) dados.insert(dados.end(), parte.begin(), parte.end());
+    return dados;
+}
+
+// Lê o arquivo inteiro. Se não abrir, avisa no cerr e devolve vetor vazio (igual ao lerCSV antigo).
+inline std::vector<double> carregarCSV(const std::string& arquivo, size_t* rejeitadas = nullptr) {
+    if (rejeitadas) *rejeitadas = 0;
+    ArquivoMapeado mapa; // sem mmap (Windows) ele lê tudo pra um buffer
+    if (!mapa.abrir(arquivo)) {
+        std::error_code erro;
+        if (std::filesystem::file_size(arquivo, erro) != 0) std::cerr << "Erro ao abrir " << arquivo << std::endl; // vazio não é erro
+        return {};
+    }
+    mapa.leituraSequencial();
+    return parseTextoCSV({mapa.dados(), mapa.tamanho()}, rejeitadas);
+}
@@ -0,0 +1,171 @@
+// Formato binário das leituras (temperaturas.bin)
+//
+// [cabeçalho de 64 bytes][valores]
+//   magic "TEMPBIN1", versão, tipo do valor (double ou int16 em centésimos de grau),
+//   quantidade de leituras e offset dos dados (alinhado em 64 bytes).
+//
+// Os valores ficam num array contíguo, então dá pra mapear o arquivo e passar um
+// std::span direto pras estruturas, sem parse nenhum.
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <span>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+#include "leitura_csv.hpp"
+#include "arquivo_mapeado.hpp"
+
+const char LEITURAS_MAGIC[8] = {'T', 'E', 'M', 'P', 'B', 'I', 'N', '1'};
+const uint32_t LEITURAS_VERSAO = 1;
+const uint64_t LEITURAS_OFFSET = 64;
+
+enum TipoLeitura : uint32_t {
+    LEITURA_DOUBLE = 0,  // double de 8 bytes
+    LEITURA_CENTI16 = 1  // int16 em centésimos de grau (22.50 -> 2250), 2 bytes
+};
+
+struct CabecalhoLeituras {
+    char magic[8];
+    uint32_t versao;
+    uint32_t tipo;
+    uint64_t quantidade;
+    uint64_t offsetDados;
+    char reservado[32];
+};
+static_assert(sizeof(CabecalhoLeituras) == LEITURAS_OFFSET, "cabecalho tem que ter 64 bytes");
+
+// Cabeçalho pra um arquivo com `quantidade` leituras (os dados começam logo depois dele)
+inline CabecalhoLeituras montarCabecalho(uint64_t quantidade, TipoLeitura tipo) {
+    CabecalhoLeituras cab{};
+    std::memcpy(cab.magic, LEITURAS_MAGIC, sizeof(cab.magic));
+    cab.versao = LEITURAS_VERSAO;
+    cab.tipo = tipo;
+    cab.quantidade = quantidade;
+    cab.offsetDados = LEITURAS_OFFSET;
+    return cab;
+}
+
+// 22.50 -> 2250
+inline int16_t paraCenti(double v) { return (int16_t)std::lround(v * 100.0); }
+
+// Grava as leituras no formato binário. Retorna false se não conseguir escrever.
+inline bool salvarBinario(const std::string& arquivo, std::span<const double> valores, TipoLeitura tipo) {
+    std::ofstream out(arquivo, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Erro ao criar " << arquivo << std::endl;
+        return false;
+    }
+    CabecalhoLeituras cab = montarCabecalho(valores.size(), tipo);
+    out.write(reinterpret_cast<const char*>(&cab), sizeof(cab));
+
+    if (tipo == LEITURA_DOUBLE) {
+        out.write(reinterpret_cast<const char*>(valores.data()), valores.size_bytes());
+    } else {
+        std::vector<int16_t> centi(valores.size());
+        for (size_t i = 0; i < valores.size(); i++) centi[i] = paraCenti(valores[i]);
+        out.write(reinterpret_cast<const char*>(centi.data()), centi.size() * sizeof(int16_t));
+    }
+    return out.good();
+}
+
+// Arquivo binário mapeado na memória (somente leitura). Desmapeia no destrutor.
+class LeiturasMapeadas {
+private:
+    ArquivoMapeado arquivo; // vazio enquanto não abriu um arquivo válido
+    CabecalhoLeituras cab{};
+
+public:
+    // Abre e valida o cabeçalho. Retorna false se o arquivo não existir ou for inválido.
+    bool abrir(const std::string& caminho) {
+        if (!arquivo.abrir(caminho) || arquivo.tamanho() < sizeof(CabecalhoLeituras)) {
+            arquivo.fechar();
+            return false;
+        }
+        std::memcpy(&cab, arquivo.dados(), sizeof(cab));
+        size_t largura = (cab.tipo == LEITURA_DOUBLE) ? sizeof(double) : sizeof(int16_t);
+        bool valido = std::memcmp(cab.magic, LEITURAS_MAGIC, sizeof(cab.magic)) == 0
+                   && cab.versao == LEITURAS_VERSAO
+                   && (cab.tipo == LEITURA_DOUBLE || cab.tipo == LEITURA_CENTI16)
+                   && cab.offsetDados >= sizeof(CabecalhoLeituras) && cab.offsetDados % 8 == 0
+                   && cab.offsetDados <= arquivo.tamanho()
+                   // dividindo: quantidade * largura estoura com uma quantidade corrompida
+                   && cab.quantidade <= (arquivo.tamanho() - cab.offsetDados) / largura;
+        if (!valido) {
+            std::cerr << "Arquivo binario invalido: " << caminho << std::endl;
+            arquivo.fechar();
+            return false;
+        }
+        return true;
+    }
+
+    TipoLeitura tipo() { return (TipoLeitura)cab.tipo; }
+    size_t quantidade() { return arquivo.dados() ? cab.quantidade : 0; }
+
+    // Valores em double direto do arquivo (só pra tipo LEITURA_DOUBLE)
+    std::span<const double> doubles() {
+        if (!arquivo.dados() || cab.tipo != LEITURA_DOUBLE) return {};
+        return {reinterpret_cast<const double*>(arquivo.dados() + cab.offsetDados), cab.quantidade};
+    }
+
+    // Valores em centésimos de grau direto do arquivo (só pra tipo LEITURA_CENTI16)
+    std::span<const int16_t> centi() {
+        if (!arquivo.dados() || cab.tipo != LEITURA_CENTI16) return {};
+        return {reinterpret_cast<const int16_t*>(arquivo.dados() + cab.offsetDados), cab.quantidade};
+    }
+};
+
+// As leituras em double, lidas direto de um array de double ou de centésimos (int16) sem
+// copiar: o int16 é convertido na hora em que cada valor é lido (2250 -> 22.50)
+class VisaoLeituras {
+private:
+    const double* d = nullptr;
+    const int16_t* c = nullptr;
+    size_t n = 0;
+
+public:
+    VisaoLeituras() = default;
+    VisaoLeituras(std::span<const double> s) : d(s.data()), n(s.size()) {}
+    VisaoLeituras(std::span<const int16_t> s) : c(s.data()), n(s.size()) {}
+
+    size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    double operator[](size_t i) const { return d ? d[i] : c[i] / 100.0; }
+
+    struct iterator {
+        const VisaoLeituras* v;
+        size_t i;
+        double operator*() const { return (*v)[i]; }
+        iterator& operator++() { i++; return *this; }
+        bool operator==(const iterator& o) const { return i == o.i; }
+    };
+    iterator begin() const { return {this, 0}; }
+    iterator end() const { return {this, n}; }
+};
+
+// Dados prontos pros benchmarks: vem do .bin mapeado quando existe, senão do CSV.
+struct Dataset {
+    LeiturasMapeadas mapa;
+    std::vector<double> copia; // só usado pro CSV
+    VisaoLeituras valores;
+    bool binario = false;
+};
+
+// Abre base + ".bin" se existir; se não, lê base + ".csv"
+inline Dataset carregarLeituras(const std::string& base) {
+    Dataset d;
+    if (d.mapa.abrir(base + ".bin")) {
+        d.binario = true;
+        // Sem cópia nos dois formatos: a visão lê do arquivo mapeado
+        if (d.mapa.tipo() == LEITURA_DOUBLE) d.valores = d.mapa.doubles();
+        else d.valores = d.mapa.centi();
+        return d;
+    }
+    d.copia = carregarCSV(base + ".csv");
+    d.valores = std::span<const double>(d.copia);
+    return d;
+}
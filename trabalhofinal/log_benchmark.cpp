@@ -0,0 +1,206 @@
+// Bibliotecas que vou usar
+#include <iostream>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <random>
+#include <cstdio>
+#include <cstdint>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "indices.hpp"
+#include "log_operacoes.hpp"
+#include "gerador.hpp"
+#include "medicao.hpp"
+
+// Uso: ./log_benchmark [--n N] [--dir D] [--remocoes P] [--dist X] [--seed S]
+//   N operações (padrão 1000000), P% delas remove de um valor já inserido (padrão 10),
+//   o log vai pra D (padrão .; os números de fsync dependem do disco: em tmpfs ele é de graça)
+//
+// 1) Vazão da ingestão nas AVLs sem log e com log em várias configurações de group commit
+//    (tamanho do bloco x fsync a cada quantos blocos). O fsync por operação é medido só
+//    nas primeiras 20000 operações (senão demora minutos num disco de verdade).
+// 2) Tempo de recuperação: refazer o log inteiro no índice vazio juntando os inserts num
+//    lote ordenado (reaplicarLog) x aplicar operação por operação, por milhão de operações.
+//    Heap e vetor removem com busca linear (O(N) por remove), então entram só num segundo
+//    log, sem removes.
+
+struct Operacao {
+    OpLog op;
+    double valor;
+};
+
+std::vector<Operacao> gerarOperacoes(const ConfigGerador& gen, int pctRemocoes) {
+    std::vector<double> dados = gerarLeituras(gen);
+    std::mt19937_64 rng(gen.semente + 1);
+    std::vector<Operacao> ops;
+    ops.reserve(dados.size());
+    std::vector<double> inseridos;
+    inseridos.reserve(dados.size());
+    for (double v : dados) {
+        if (!inseridos.empty() && (int)(rng() % 100) < pctRemocoes) {
+            size_t i = rng() % inseridos.size();
+            ops.push_back({OP_REMOVE, inseridos[i]});
+            inseridos[i] = inseridos.back();
+            inseridos.pop_back();
+        } else {
+            ops.push_back({OP_INSERT, v});
+            inseridos.push_back(v);
+        }
+    }
+    return ops;
+}
+
+// O mesmo laço com e sem log (fora de linha: inlinado direto no índice o laço sem log
+// saía com outro código e a comparação media o compilador, não o log)
+template <typename Destino>
+[[gnu::noinline]] void aplicarOperacoes(Destino& destino, const std::vector<Operacao>& ops, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (ops[i].op == OP_INSERT) destino.insert(ops[i].valor);
+        else destino.remove(ops[i].valor);
+    }
+}
+
+// Os nós das árvores já destruídas ficam nas listas rápidas do malloc até a próxima alocação
+// grande, que junta tudo (no glibc). Sem isso a medida dependia de quem pagava essa conta:
+// a árvore com log (o buffer do log é uma alocação grande) saía com nós em sequência e mais
+// rápida que a sem log, e o replay em lote pagava a limpeza das árvores anteriores.
+void juntarMemoriaLivre() {
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
+
+// Aplica as operações no índice (registrando no log quando tem um) e devolve o tempo em ns
+template <typename Indice>
+double ingerir(const std::vector<Operacao>& ops, size_t n, const std::string* arquivoLog, ConfigLog cfg) {
+    juntarMemoriaLivre();
+    Indice idx;
+    if (!arquivoLog) return cronometrar([&] { aplicarOperacoes(idx, ops, n); });
+    std::remove(arquivoLog->c_str());
+    IndiceComLog<Indice> comLog(idx, "", *arquivoLog, cfg);
+    comLog.recuperar();
+    return cronometrar([&] {
+        aplicarOperacoes(comLog, ops, n);
+        comLog.confirmar();
+    });
+}
+
+struct CenarioIngestao {
+    std::string nome;
+    bool comLog;
+    ConfigLog cfg;
+    bool poucas; // só as primeiras 20000 operações
+};
+
+template <typename Indice>
+void medirIngestao(const std::string& nome, const std::vector<Operacao>& ops, const std::string& arquivoLog) {
+    const CenarioIngestao configs[] = {
+        {"sem log", false, {}, false},
+        {"bloco 4096, sem fsync", true, {4096, 0}, false},
+        {"bloco 4096, fsync/64 blocos", true, {4096, 64}, false},
+        {"bloco 4096, fsync/bloco", true, {4096, 1}, false},
+        {"bloco 64, fsync/bloco", true, {64, 1}, false},
+        {"fsync por operacao", true, {1, 1}, true},
+    };
+    std::cout << "\n[" << nome << "] " << std::left << std::setw(30) << "ingestao" << std::right
+              << std::setw(14) << "Mops/s" << std::setw(14) << "ns/op" << std::setw(12) << "custo" << std::endl;
+    double base = 0;
+    for (const CenarioIngestao& c : configs) {
+        size_t n = c.poucas ? std::min<size_t>(ops.size(), 20000) : ops.size();
+        std::vector<double> amostras;
+        repetir(ConfigMedicao{1, 3, 10.0}, [&](bool valendo) {
+            double ns = ingerir<Indice>(ops, n, c.comLog ? &arquivoLog : nullptr, c.cfg);
+            if (valendo) amostras.push_back(ns / n);
+        });
+        double nsPorOp = resumir(amostras).mediana;
+        if (!c.comLog) base = nsPorOp;
+        std::cout << std::setw(nome.size() + 3) << "" << std::left << std::setw(30) << c.nome << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(14) << 1e3 / nsPorOp
+                  << std::setprecision(0) << std::setw(14) << nsPorOp;
+        if (c.comLog) std::cout << std::setw(11) << std::setprecision(0) << (nsPorOp / base - 1) * 100 << "%";
+        std::cout << std::endl;
+    }
+}
+
+// Refaz o log no índice vazio: operação por operação x lote ordenado. Confere que dá igual.
+template <typename Indice>
+bool medirRecuperacao(const std::string& nome, const std::string& arquivoLog, Indice umAUm, Indice emLote) {
+    ResumoLog r;
+    juntarMemoriaLivre();
+    double tUmAUm = cronometrar([&] {
+        r = lerLog<double>(arquivoLog, [&](std::span<const uint8_t> ops, std::span<const double> chaves) {
+            for (size_t i = 0; i < ops.size(); i++) {
+                if (ops[i] == OP_INSERT) umAUm.insert(chaves[i]);
+                else umAUm.remove(chaves[i]);
+            }
+        });
+    });
+    juntarMemoriaLivre();
+    double tLote = cronometrar([&] { reaplicarLog(arquivoLog, emLote); });
+    bool igual = umAUm.count() == emLote.count() && umAUm.min(1000) == emLote.min(1000)
+              && umAUm.max(1000) == emLote.max(1000) && umAUm.median() == emLote.median();
+    double milhoes = r.operacoes / 1e6;
+    std::cout << std::left << std::setw(12) << nome << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << tUmAUm / 1e6 << std::setw(14) << tLote / 1e6
+              << std::setw(16) << tUmAUm / 1e6 / milhoes << std::setw(16) << tLote / 1e6 / milhoes
+              << std::setw(9) << tUmAUm / tLote << "x" << "   " << (igual ? "igual" : "DIFERENTE") << std::endl;
+    return igual;
+}
+
+int main(int argc, char* argv[]) {
+    ConfigGerador gen;
+    gen.n = 1000000;
+    std::string dir = ".";
+    int pctRemocoes = 10;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--n" && temValor) gen.n = (uint64_t)std::stod(argv[++i]);
+        else if (arg == "--dir" && temValor) dir = argv[++i];
+        else if (arg == "--remocoes" && temValor) pctRemocoes = std::stoi(argv[++i]);
+        else if (arg == "--seed" && temValor) gen.semente = std::stoull(argv[++i]);
+        else if (arg == "--dist" && temValor && distribuicaoPorNome(argv[++i], gen.dist)) {}
+        else {
+            std::cerr << "Uso: ./log_benchmark [--n N] [--dir D] [--remocoes P] [--dist " << nomesDistribuicoes()
+                      << "] [--seed S]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<Operacao> ops = gerarOperacoes(gen, pctRemocoes);
+    std::string arquivoLog = dir + "/operacoes.log";
+    std::cout << ops.size() << " operacoes (" << pctRemocoes << "% remove), log em " << arquivoLog << std::endl;
+
+    medirIngestao<AVLTree<>>("AVL", ops, arquivoLog);
+    medirIngestao<CountedAVLTree<>>("AVL(cont)", ops, arquivoLog);
+
+    auto gravarLog = [&](const std::vector<Operacao>& lista) {
+        std::remove(arquivoLog.c_str());
+        LogOperacoes<double> log;
+        log.abrir(arquivoLog, ConfigLog{4096, 0});
+        for (const Operacao& o : lista) log.registrar(o.op, o.valor);
+    };
+    auto cabecalho = [](const std::string& titulo) {
+        std::cout << "\n" << titulo << "\n" << std::left << std::setw(12) << "Recuperacao" << std::right
+                  << std::setw(14) << "um a um (ms)" << std::setw(14) << "lote (ms)" << std::setw(16) << "um a um ms/1M"
+                  << std::setw(16) << "lote ms/1M" << std::setw(10) << "ganho" << std::endl;
+    };
+
+    bool iguais = true;
+    gravarLog(ops);
+    cabecalho("Log com " + std::to_string(pctRemocoes) + "% remove:");
+    iguais &= medirRecuperacao("AVL", arquivoLog, AVLTree<>(), AVLTree<>());
+    iguais &= medirRecuperacao("AVL(cont)", arquivoLog, CountedAVLTree<>(), CountedAVLTree<>());
+
+    gravarLog(gerarOperacoes(gen, 0));
+    cabecalho("Log so com inserts:");
+    iguais &= medirRecuperacao("AVL", arquivoLog, AVLTree<>(), AVLTree<>());
+    iguais &= medirRecuperacao("AVL(cont)", arquivoLog, CountedAVLTree<>(), CountedAVLTree<>());
+    iguais &= medirRecuperacao("HEAP", arquivoLog, PureMinHeap<>(), PureMinHeap<>());
+    iguais &= medirRecuperacao("VEC(adapt)", arquivoLog, VectorInsertionSort<>(true), VectorInsertionSort<>(true));
+    std::remove(arquivoLog.c_str());
+    return iguais ? 0 : 1;
+}
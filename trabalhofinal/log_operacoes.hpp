@@ -0,0 +1,493 @@
+// Log de operações (write-ahead log) dos índices: insert/remove gravados antes de aplicar
+//
+// [cabeçalho de 64 bytes][bloco][bloco]...
+//   cabeçalho: magic "IDXLOG01", versão, tipo da chave e a geração do log
+//   bloco:     [quantidade, marca, soma][operações (1 byte cada, completado até 8)][chaves]
+//
+// As operações ficam num buffer e vão pro disco em blocos (group commit): um write por
+// bloco de opsPorBloco operações e um fsync a cada blocosPorSync blocos, em vez de um
+// fsync por operação. O que ainda está no buffer se perde se o processo cair; confirmar()
+// força o bloco e o fsync quando precisa garantir.
+// Se um write ou fsync falhar, o log corta o arquivo de volta no fim do último bloco bom e
+// para de aceitar operações (registrar/confirmar retornam false): blocos escritos depois de
+// um bloco quebrado nunca seriam lidos na volta. Só um checkpoint() (log novo) destrava.
+//
+// Na volta o log é lido até o primeiro bloco cortado ou com soma errada (o resto é lixo de
+// uma escrita que não terminou) e os inserts são juntados num lote só, aplicado com
+// bulkLoad/insertBatch (que ordenam e montam de uma vez), em vez de N inserts de O(log N).
+//
+// Com o estado de estado_bin.hpp: checkpoint() grava o estado marcando a próxima geração
+// e recomeça o log nela. Se cair entre as duas coisas, o log velho (geração menor que a do
+// estado) é ignorado na volta, então nenhuma operação é aplicada duas vezes.
+//
+//   AVLTree<> avl;
+//   IndiceComLog idx(avl, "estado_avl.bin", "avl.log");
+//   idx.recuperar();          // load do estado + replay do log
+//   idx.insert(22.5);         // grava no log e aplica
+//   idx.checkpoint();         // de vez em quando: estado novo e log vazio
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <span>
+#include <unordered_map>
+#include <algorithm>
+#include <filesystem>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <type_traits>
+
+#include "indice.hpp"
+#include "estado_bin.hpp"
+#include "arquivo_mapeado.hpp"
+
+const char LOG_MAGIC[8] = {'I', 'D', 'X', 'L', 'O', 'G', '0', '1'};
+const uint32_t LOG_VERSAO = 1;
+const uint64_t LOG_OFFSET = 64;
+const uint32_t LOG_MARCA_BLOCO = 0x434F4C42; // "BLOC"
+
+enum OpLog : uint8_t {
+    OP_INSERT = 1,
+    OP_REMOVE = 2
+};
+
+struct CabecalhoLog {
+    char magic[8];
+    uint32_t versao;
+    uint32_t tamanhoChave; // sizeof(Key)
+    uint32_t chaveInteira; // 1 pra chave inteira, 0 pra ponto flutuante
+    uint32_t reservado0;
+    uint64_t geracao;      // sobe a cada checkpoint (ver estado_bin.hpp: geracaoLog)
+    char reservado[32];
+};
+static_assert(sizeof(CabecalhoLog) == LOG_OFFSET, "cabecalho tem que ter 64 bytes");
+
+struct CabecalhoBloco {
+    uint32_t quantidade;
+    uint32_t marca;        // LOG_MARCA_BLOCO
+    uint64_t soma;         // somaVerificacao das operações + chaves
+};
+static_assert(sizeof(CabecalhoBloco) == 16, "cabecalho do bloco tem que ter 16 bytes");
+
+// Bytes das operações de um bloco (completado até múltiplo de 8 pra as chaves ficarem alinhadas)
+inline size_t bytesOps(size_t quantidade) { return (quantidade + 7) & ~size_t(7); }
+
+struct ConfigLog {
+    size_t opsPorBloco = 4096;  // operações por write
+    size_t blocosPorSync = 1;   // fsync a cada quantos blocos (0 = nunca, deixa pro sistema)
+};
+
+// O que a leitura do log encontrou
+struct ResumoLog {
+    bool existe = false;    // tinha um log com cabeçalho válido
+    bool invalido = false;  // tinha um arquivo, mas o cabeçalho não é de um log que dá pra ler aqui
+    uint64_t geracao = 0;
+    size_t blocos = 0;
+    size_t operacoes = 0;
+    size_t bytesValidos = 0; // até onde o log está inteiro
+    bool cortado = false;    // tinha lixo depois do último bloco bom
+};
+
+// Só a geração do cabeçalho (0 se o log não existe ou não é um log)
+inline uint64_t geracaoDoLog(const std::string& caminho) {
+    CabecalhoLog cab{};
+    std::ifstream in(caminho, std::ios::binary);
+    if (!in.read(reinterpret_cast<char*>(&cab), sizeof(cab))) return 0;
+    if (std::memcmp(cab.magic, LOG_MAGIC, sizeof(cab.magic)) != 0) return 0;
+    return cab.geracao;
+}
+
+// Percorre os blocos válidos do log chamando visitar(ops, chaves) pra cada um.
+// Para no primeiro bloco cortado ou com soma errada.
+template <typename Key, typename F>
+ResumoLog lerLog(const std::string& caminho, F&& visitar) {
+    ResumoLog r;
+    ArquivoMapeado arquivo;
+    if (!arquivo.abrir(caminho)) return r;
+    if (arquivo.tamanho() < sizeof(CabecalhoLog)) {
+        std::cerr << "Log invalido (arquivo curto): " << caminho << std::endl;
+        r.invalido = true;
+        return r;
+    }
+    CabecalhoLog cab;
+    std::memcpy(&cab, arquivo.dados(), sizeof(cab));
+    if (std::memcmp(cab.magic, LOG_MAGIC, sizeof(cab.magic)) != 0 || cab.versao == 0 || cab.versao > LOG_VERSAO
+        || cab.tamanhoChave != sizeof(Key) || cab.chaveInteira != std::is_integral_v<Key>) {
+        std::cerr << "Log invalido (cabecalho): " << caminho << std::endl;
+        r.invalido = true;
+        return r;
+    }
+    r.existe = true;
+    r.geracao = cab.geracao;
+    size_t pos = sizeof(CabecalhoLog);
+    const char* base = arquivo.dados();
+    while (pos + sizeof(CabecalhoBloco) <= arquivo.tamanho()) {
+        CabecalhoBloco b;
+        std::memcpy(&b, base + pos, sizeof(b));
+        size_t corpo = bytesOps(b.quantidade) + (size_t)b.quantidade * sizeof(Key);
+        if (b.marca != LOG_MARCA_BLOCO || b.quantidade == 0 || corpo > arquivo.tamanho() - pos - sizeof(b)) break;
+        const char* p = base + pos + sizeof(b);
+        if (somaVerificacao(p, corpo) != b.soma) break;
+        visitar(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(p), b.quantidade),
+                std::span<const Key>(reinterpret_cast<const Key*>(p + bytesOps(b.quantidade)), b.quantidade));
+        pos += sizeof(b) + corpo;
+        r.blocos++;
+        r.operacoes += b.quantidade;
+    }
+    r.bytesValidos = pos;
+    r.cortado = pos < arquivo.tamanho();
+    return r;
+}
+
+// Lado que grava o log
+template <typename Key>
+class LogOperacoes {
+private:
+    std::string caminho;
+    ConfigLog cfg;
+    uint64_t ger = 0;
+    std::vector<uint8_t> ops;   // bloco em montagem
+    std::vector<Key> chaves;
+    std::vector<char> bloco;    // bloco serializado (reaproveitado entre writes)
+    size_t semSync = 0;         // blocos escritos depois do último fsync
+    size_t bytesBons = 0;       // fim do último bloco escrito inteiro
+    bool falhou = false;        // write/fsync falhou: não aceita mais nada até reiniciar()
+#ifdef ARQUIVO_MMAP
+    int fd = -1;
+#else
+    std::ofstream out;          // fora de Unix: flush no lugar do fsync
+#endif
+
+    bool aberto() const {
+#ifdef ARQUIVO_MMAP
+        return fd >= 0;
+#else
+        return out.is_open();
+#endif
+    }
+
+    bool escrever(const char* p, size_t n) {
+#ifdef ARQUIVO_MMAP
+        while (n > 0) {
+            ssize_t w = ::write(fd, p, n);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            p += w;
+            n -= w;
+        }
+        return true;
+#else
+        return (bool)out.write(p, n);
+#endif
+    }
+
+    bool sincronizar() {
+        if (semSync == 0) return true;
+#if defined(ARQUIVO_MMAP) && defined(__linux__)
+        bool ok = fdatasync(fd) == 0; // só os dados e o tamanho, sem a data de modificação
+#elif defined(ARQUIVO_MMAP)
+        bool ok = fsync(fd) == 0;
+#else
+        bool ok = (bool)out.flush();
+#endif
+        if (!ok) return falhar("fsync");
+        semSync = 0;
+        return true;
+    }
+
+    // Trava o log e tira do arquivo o pedaço do bloco que não foi inteiro
+    bool falhar(const char* onde) {
+        std::cerr << "Erro no log (" << onde << "), parando de gravar: " << caminho << std::endl;
+        falhou = true;
+        ops.clear();
+        chaves.clear();
+#ifdef ARQUIVO_MMAP
+        if (::ftruncate(fd, bytesBons) != 0) std::cerr << "Erro ao cortar o log " << caminho << std::endl;
+#else
+        out.close();
+        std::error_code erro;
+        std::filesystem::resize_file(caminho, bytesBons, erro);
+#endif
+        return false;
+    }
+
+    void abrirParaAcrescentar() {
+#ifdef ARQUIVO_MMAP
+        fd = ::open(caminho.c_str(), O_WRONLY | O_APPEND);
+#else
+        out.open(caminho, std::ios::binary | std::ios::app);
+#endif
+    }
+
+    // Escreve o bloco em montagem (um write só) e faz o fsync se já juntou blocosPorSync
+    bool gravarBloco() {
+        if (falhou) return false;
+        if (ops.empty()) return true;
+        CabecalhoBloco b{};
+        b.quantidade = ops.size();
+        b.marca = LOG_MARCA_BLOCO;
+        size_t nOps = bytesOps(ops.size());
+        bloco.assign(sizeof(b) + nOps + chaves.size() * sizeof(Key), 0);
+        char* corpo = bloco.data() + sizeof(b);
+        std::memcpy(corpo, ops.data(), ops.size());
+        std::memcpy(corpo + nOps, chaves.data(), chaves.size() * sizeof(Key));
+        b.soma = somaVerificacao(corpo, bloco.size() - sizeof(b));
+        std::memcpy(bloco.data(), &b, sizeof(b));
+        if (!escrever(bloco.data(), bloco.size())) return falhar("write");
+        bytesBons += bloco.size();
+        ops.clear();
+        chaves.clear();
+        semSync++;
+        if (cfg.blocosPorSync != 0 && semSync >= cfg.blocosPorSync) return sincronizar();
+        return true;
+    }
+
+public:
+    LogOperacoes() = default;
+    LogOperacoes(const LogOperacoes&) = delete;
+    LogOperacoes& operator=(const LogOperacoes&) = delete;
+    ~LogOperacoes() { fechar(); }
+
+    // Abre o log pra continuar escrevendo: corta o lixo depois do último bloco bom.
+    // Se não existir começa um log vazio na geração 1. Cabeçalho inválido (outro tipo de
+    // chave, versão mais nova) retorna false sem mexer no arquivo.
+    bool abrir(const std::string& arquivo, ConfigLog config = {}) {
+        fechar();
+        caminho = arquivo;
+        cfg = config;
+        falhou = false;
+        cfg.opsPorBloco = std::clamp<size_t>(cfg.opsPorBloco, 1, UINT32_MAX);
+        ResumoLog r = lerLog<Key>(caminho, [](auto, auto) {});
+        if (r.invalido) return false;
+        if (!r.existe) return reiniciar(1);
+        ger = r.geracao;
+        if (r.cortado) {
+            std::error_code erro;
+            std::filesystem::resize_file(caminho, r.bytesValidos, erro);
+            if (erro) {
+                std::cerr << "Erro ao cortar o log " << caminho << ": " << erro.message() << std::endl;
+                return false;
+            }
+        }
+        bytesBons = r.bytesValidos;
+        abrirParaAcrescentar();
+        ops.reserve(cfg.opsPorBloco);
+        chaves.reserve(cfg.opsPorBloco);
+        return aberto();
+    }
+
+    // Troca o log por um vazio na geração `geracao` (.tmp + rename, como o estado)
+    bool reiniciar(uint64_t geracao) {
+        fechar();
+        CabecalhoLog cab{};
+        std::memcpy(cab.magic, LOG_MAGIC, sizeof(cab.magic));
+        cab.versao = LOG_VERSAO;
+        cab.tamanhoChave = sizeof(Key);
+        cab.chaveInteira = std::is_integral_v<Key>;
+        cab.geracao = geracao;
+        // Mesma troca atômica do estado (com fsync): o log novo não pode sumir numa queda
+        // depois que o checkpoint já gravou o estado apontando pra geração dele
+        if (!substituirArquivo(caminho, &cab, sizeof(cab), nullptr, 0)) return false;
+        ger = geracao;
+        bytesBons = sizeof(CabecalhoLog);
+        falhou = false;
+        abrirParaAcrescentar();
+        ops.reserve(cfg.opsPorBloco);
+        chaves.reserve(cfg.opsPorBloco);
+        return aberto();
+    }
+
+    // Guarda a operação no bloco em montagem; o bloco cheio vai pro disco.
+    // false: o log não está aberto ou falhou (agora ou antes) e a operação não foi registrada;
+    // as do bloco que falhou também se perderam.
+    bool registrar(OpLog op, Key valor) {
+        if (!aberto() || falhou) return false;
+        ops.push_back(op);
+        chaves.push_back(valor);
+        if (ops.size() >= cfg.opsPorBloco) return gravarBloco();
+        return true;
+    }
+
+    // Group commit: escreve o bloco pendente e faz o fsync, independente do blocosPorSync.
+    // Retornando true, tudo registrado até aqui sobrevive a uma queda.
+    bool confirmar() {
+        if (!aberto() || falhou) return false;
+        return gravarBloco() && sincronizar();
+    }
+
+    // Escreve o que falta e fecha (fsync só se o log sincroniza)
+    void fechar() {
+        if (!aberto()) return;
+        if (gravarBloco() && cfg.blocosPorSync != 0) sincronizar();
+#ifdef ARQUIVO_MMAP
+        ::close(fd);
+        fd = -1;
+#else
+        out.close();
+#endif
+        semSync = 0;
+    }
+
+    uint64_t geracao() const { return ger; }
+    size_t pendentes() const { return ops.size(); }
+    bool ok() const { return aberto() && !falhou; }
+};
+
+// Coloca o lote no índice do jeito mais barato que ele tiver. As AVLs ordenam o lote e
+// juntam de uma vez (montagem balanceada em O(N) / um nó por valor distinto); o heap refaz
+// com Floyd; o vetor só acrescenta na cauda, que é intercalada na primeira consulta.
+template <typename Indice, typename Key>
+void aplicarLote(Indice& indice, std::span<const Key> lote) {
+    if (lote.empty()) return;
+    if constexpr (requires { indice.bulkLoad(lote); }) {
+        if (indice.isEmpty()) { indice.bulkLoad(lote); return; }
+    }
+    if constexpr (requires { indice.insertBatch(lote); }) indice.insertBatch(lote);
+    else for (Key v : lote) indice.insert(v);
+}
+
+// Aplica as operações do log juntando os inserts: eles ficam pendentes e entram num lote
+// só no fim (aplicarLote). Um remove de um valor que ainda está pendente cancela esse insert
+// (dá o mesmo multiconjunto que aplicar em ordem); os outros removes vão direto pro índice,
+// que nesse momento tem o mesmo número de cópias do valor que teria na ordem original.
+template <TemperatureIndex Indice>
+class ReaplicadorLog {
+private:
+    using Key = typename Indice::key_type;
+    Indice& indice;
+    std::vector<Key> pendentes;
+    std::unordered_map<Key, uint32_t> contagem; // só é montado no primeiro remove com inserts pendentes
+    bool contando = false;
+
+public:
+    explicit ReaplicadorLog(Indice& idx) : indice(idx) {}
+
+    void reservar(size_t operacoes) { pendentes.reserve(operacoes); }
+
+    void bloco(std::span<const uint8_t> ops, std::span<const Key> chaves) {
+        for (size_t i = 0; i < ops.size(); i++) {
+            if (ops[i] == OP_INSERT) {
+                pendentes.push_back(chaves[i]);
+                if (contando) contagem[chaves[i]]++;
+            } else if (ops[i] == OP_REMOVE) {
+                remove(chaves[i]);
+            }
+        }
+    }
+
+    void remove(Key v) {
+        if (!pendentes.empty()) {
+            if (!contando) {
+                contagem.reserve(pendentes.size());
+                for (Key p : pendentes) contagem[p]++;
+                contando = true;
+            }
+            auto it = contagem.find(v);
+            if (it != contagem.end() && it->second > 0) {
+                it->second--;
+                return;
+            }
+        }
+        indice.remove(v);
+    }
+
+    // Aplica de uma vez o que ficou pendente
+    void descarregar() {
+        if (contando) {
+            pendentes.clear();
+            for (auto& [k, c] : contagem) pendentes.insert(pendentes.end(), c, k);
+            contagem.clear();
+            contando = false;
+        }
+        aplicarLote(indice, std::span<const Key>(pendentes));
+        pendentes.clear();
+    }
+};
+
+// Refaz no índice as operações do log (a partir da geração `desdeGeracao`: log mais velho
+// que isso já está dentro do estado e é ignorado)
+template <TemperatureIndex Indice>
+ResumoLog reaplicarLog(const std::string& caminho, Indice& indice, uint64_t desdeGeracao = 0) {
+    using Key = typename Indice::key_type;
+    ReaplicadorLog<Indice> rep(indice);
+    if (geracaoDoLog(caminho) < desdeGeracao) return lerLog<Key>(caminho, [](auto, auto) {});
+    std::error_code erro;
+    uintmax_t bytes = std::filesystem::file_size(caminho, erro);
+    if (!erro) rep.reservar(bytes / (1 + sizeof(Key))); // no máximo isso de operações
+    ResumoLog r = lerLog<Key>(caminho, [&](std::span<const uint8_t> ops, std::span<const Key> chaves) {
+        rep.bloco(ops, chaves);
+    });
+    rep.descarregar();
+    return r;
+}
+
+// Índice com log: cada insert/remove vai pro log antes de ser aplicado.
+// Chame recuperar() antes de usar; checkpoint() só existe pra índices com save/load.
+template <TemperatureIndex Indice>
+class IndiceComLog {
+public:
+    using key_type = typename Indice::key_type;
+
+private:
+    Indice& indice;
+    std::string arquivoEstado;
+    std::string arquivoLog;
+    ConfigLog cfg;
+    LogOperacoes<key_type> log;
+    uint64_t geracaoEstado = 0; // geração gravada no estado carregado
+
+public:
+    IndiceComLog(Indice& idx, std::string estado, std::string caminhoLog, ConfigLog config = {})
+        : indice(idx), arquivoEstado(std::move(estado)), arquivoLog(std::move(caminhoLog)), cfg(config) {}
+
+    // Carrega o último estado (se o índice tiver load), refaz o log por cima e deixa o log
+    // aberto pra continuar. Log mais velho que o estado (queda no meio do checkpoint) é descartado.
+    // Log inválido (r.invalido) fica como está e insert/remove recusam até um checkpoint().
+    ResumoLog recuperar() {
+        geracaoEstado = 0;
+        if constexpr (requires { indice.load(arquivoEstado); }) {
+            if (indice.load(arquivoEstado)) geracaoEstado = geracaoLogDoEstado(arquivoEstado);
+        }
+        ResumoLog r = reaplicarLog(arquivoLog, indice, geracaoEstado);
+        // Só mexe no arquivo se ele abriu: com cabeçalho ilegível a geração fica 0 e o
+        // reiniciar trocaria o log (com operações confirmadas) por um vazio
+        bool abriu = log.abrir(arquivoLog, cfg);
+        if (abriu && !r.invalido && log.geracao() < geracaoEstado) log.reiniciar(geracaoEstado);
+        return r;
+    }
+
+    // false: o log recusou (não abriu ou falhou) e a operação não foi aplicada. As operações
+    // aceitas desde o último confirmar() podem não estar no disco: um checkpoint() grava o
+    // índice inteiro e começa um log novo.
+    bool insert(key_type v) {
+        if (!log.registrar(OP_INSERT, v)) return false;
+        indice.insert(v);
+        return true;
+    }
+
+    bool remove(key_type v) {
+        if (!log.registrar(OP_REMOVE, v)) return false;
+        indice.remove(v);
+        return true;
+    }
+
+    bool confirmar() { return log.confirmar(); }
+
+    // Grava o estado marcando a próxima geração e recomeça o log vazio nela. Também é a
+    // saída depois de uma falha do log: o estado tem tudo que foi aplicado no índice.
+    bool checkpoint() requires requires(Indice& i, const std::string& s, uint64_t g) { i.save(s, g); } {
+        log.confirmar(); // se o log já falhou, o que ele perdeu vai junto no estado
+        uint64_t proxima = std::max(log.geracao(), geracaoEstado) + 1; // log inválido tem geração 0
+        if (!indice.save(arquivoEstado, proxima)) return false;
+        return log.reiniciar(proxima);
+    }
+
+    Indice& operator*() { return indice; }
+    Indice* operator->() { return &indice; }
+    LogOperacoes<key_type>& operacoes() { return log; }
+};
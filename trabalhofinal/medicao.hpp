@@ -0,0 +1,164 @@
+// Medição de tempo pros benchmarks
+// - repete cada medida várias vezes (com aquecimento antes) e resume em mediana/p95/p99
+// - desconta o custo do próprio relógio
+// - naoOtimizar() segura os resultados pra o compilador não apagar a operação medida
+// - salva tudo em CSV ou JSON pra comparar rodadas e montar gráficos
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+// Faz o compilador achar que o valor é usado (e que a memória pode ter mudado)
+template <typename T>
+inline void naoOtimizar(const T& valor) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(valor) : "memory");
+#else
+    static const volatile void* sumidouro;
+    sumidouro = &valor;
+#endif
+}
+
+using RelogioMedicao = std::chrono::steady_clock;
+
+// Tempo em ns entre duas leituras do relógio sem nada no meio (mediana de 1001 tentativas)
+inline double custoRelogioNs() {
+    static const double custo = [] {
+        std::vector<double> t(1001);
+        for (double& x : t) {
+            auto a = RelogioMedicao::now();
+            auto b = RelogioMedicao::now();
+            x = std::chrono::duration<double, std::nano>(b - a).count();
+        }
+        std::nth_element(t.begin(), t.begin() + t.size() / 2, t.end());
+        return t[t.size() / 2];
+    }();
+    return custo;
+}
+
+// Roda op() uma vez e devolve quanto levou em ns (já sem o custo do relógio)
+template <typename F>
+inline double cronometrar(F&& op) {
+    auto a = RelogioMedicao::now();
+    op();
+    auto b = RelogioMedicao::now();
+    double ns = std::chrono::duration<double, std::nano>(b - a).count() - custoRelogioNs();
+    return std::max(ns, 0.0);
+}
+
+struct ConfigMedicao {
+    int aquecimento = 3;    // rodadas descartadas antes de medir
+    int repeticoes = 31;    // rodadas medidas (no máximo)
+    double orcamentoSeg = 2.0; // tempo total por medida; passou disso, para com o que tiver
+};
+
+struct Estatisticas {
+    size_t amostras = 0;
+    double mediana = 0, p95 = 0, p99 = 0, minimo = 0, maximo = 0, media = 0;
+};
+
+// Percentil pelo método do rank mais próximo (amostras já ordenadas)
+inline double percentilOrdenado(const std::vector<double>& v, double p) {
+    if (v.empty()) return 0.0;
+    size_t k = (size_t)std::ceil(p / 100.0 * v.size());
+    return v[std::clamp<size_t>(k, 1, v.size()) - 1];
+}
+
+inline Estatisticas resumir(std::vector<double> ns) {
+    Estatisticas e;
+    if (ns.empty()) return e;
+    std::sort(ns.begin(), ns.end());
+    e.amostras = ns.size();
+    e.minimo = ns.front();
+    e.maximo = ns.back();
+    e.mediana = (ns.size() % 2) ? ns[ns.size() / 2] : (ns[ns.size() / 2 - 1] + ns[ns.size() / 2]) / 2.0;
+    e.p95 = percentilOrdenado(ns, 95);
+    e.p99 = percentilOrdenado(ns, 99);
+    double soma = 0;
+    for (double x : ns) soma += x;
+    e.media = soma / ns.size();
+    return e;
+}
+
+// Chama rodada(medir) primeiro pro aquecimento (medir = false) e depois pras repetições
+// (medir = true), até completar ou estourar o orçamento. Quem chama cronometra o que
+// interessa dentro da rodada e guarda as amostras. Se uma rodada de aquecimento sozinha
+// já estoura o orçamento, não repete: a próxima rodada medida é a única.
+// Retorna quantas rodadas medidas foram feitas.
+template <typename F>
+inline int repetir(const ConfigMedicao& cfg, F&& rodada) {
+    auto inicio = RelogioMedicao::now();
+    auto gasto = [&] { return std::chrono::duration<double>(RelogioMedicao::now() - inicio).count(); };
+
+    for (int i = 0; i < cfg.aquecimento && gasto() < cfg.orcamentoSeg; i++) rodada(false);
+    bool semTempo = gasto() >= cfg.orcamentoSeg;
+
+    inicio = RelogioMedicao::now();
+    int feitas = 0;
+    while (feitas < cfg.repeticoes) {
+        rodada(true);
+        feitas++;
+        if (semTempo || gasto() >= cfg.orcamentoSeg) break;
+    }
+    return feitas;
+}
+
+// Uma linha de resultado: estrutura x tamanho x operação
+struct ResultadoMedicao {
+    std::string estrutura;
+    std::string operacao;
+    size_t n = 0;
+    Estatisticas ns;
+};
+
+inline bool salvarCSV(const std::string& arquivo, const std::vector<ResultadoMedicao>& res) {
+    std::ofstream out(arquivo);
+    if (!out.is_open()) {
+        std::cerr << "Erro ao criar " << arquivo << std::endl;
+        return false;
+    }
+    out << std::fixed << std::setprecision(1);
+    out << "estrutura,n,operacao,amostras,mediana_ns,p95_ns,p99_ns,min_ns,max_ns,media_ns\n";
+    for (const ResultadoMedicao& r : res) {
+        out << r.estrutura << ',' << r.n << ',' << r.operacao << ',' << r.ns.amostras << ','
+            << r.ns.mediana << ',' << r.ns.p95 << ',' << r.ns.p99 << ','
+            << r.ns.minimo << ',' << r.ns.maximo << ',' << r.ns.media << '\n';
+    }
+    return out.good();
+}
+
+inline std::string textoJSON(const std::string& s) {
+    std::string r = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') r += '\\';
+        r += c;
+    }
+    return r + "\"";
+}
+
+inline bool salvarJSON(const std::string& arquivo, const std::vector<ResultadoMedicao>& res) {
+    std::ofstream out(arquivo);
+    if (!out.is_open()) {
+        std::cerr << "Erro ao criar " << arquivo << std::endl;
+        return false;
+    }
+    out << std::fixed << std::setprecision(1);
+    out << "[\n";
+    for (size_t i = 0; i < res.size(); i++) {
+        const ResultadoMedicao& r = res[i];
+        out << "  {\"estrutura\": " << textoJSON(r.estrutura) << ", \"n\": " << r.n
+            << ", \"operacao\": " << textoJSON(r.operacao) << ", \"amostras\": " << r.ns.amostras
+            << ", \"mediana_ns\": " << r.ns.mediana << ", \"p95_ns\": " << r.ns.p95
+            << ", \"p99_ns\": " << r.ns.p99 << ", \"min_ns\": " << r.ns.minimo
+            << ", \"max_ns\": " << r.ns.maximo << ", \"media_ns\": " << r.ns.media << "}"
+            << (i + 1 < res.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+    return out.good();
+}
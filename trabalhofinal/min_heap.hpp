@@ -0,0 +1,438 @@
+// Heaps dos benchmarks
+// - StreamingMedian: dois heaps com a mediana em O(1) (usado pela PureMinHeap)
+// - PureMinHeap: heap mínimo d-ário num vetor alinhado, montagem em O(N), remoção com busca linear, save/load
+// - IndexedMinHeap: heap mínimo com índice valor -> posições, remoção em O(log N)
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <limits>
+#include <span>
+#include <new>
+#include <string>
+#include <cstdint>
+
+#include "indice.hpp"
+#include "estado_bin.hpp"
+
+// Mediana em streaming: max-heap com a metade menor e min-heap com a maior.
+// Remoção é preguiçosa: o valor fica marcado e só sai quando chega no topo.
+template <typename Key = double, typename Compare = std::less<Key>>
+class StreamingMedian {
+private:
+    // Inverte o comparador pra montar o min-heap da metade maior
+    struct Invertido {
+        Compare comp;
+        bool operator()(const Key& a, const Key& b) const { return comp(b, a); }
+    };
+
+    std::priority_queue<Key, std::vector<Key>, Compare> lo;    // metade menor
+    std::priority_queue<Key, std::vector<Key>, Invertido> hi;  // metade maior
+    std::unordered_map<Key, int> delayed; // valores removidos que ainda estão nos heaps
+    int loSize = 0, hiSize = 0;           // quantidade de valores válidos em cada lado
+    Compare comp;
+
+    // Tira do topo os valores que já foram removidos
+    template <typename Heap>
+    void prune(Heap& h) {
+        while (!h.empty()) {
+            auto it = delayed.find(h.top());
+            if (it == delayed.end()) break;
+            if (--it->second == 0) delayed.erase(it);
+            h.pop();
+        }
+    }
+
+    // Mantém loSize == hiSize ou loSize == hiSize + 1
+    void rebalance() {
+        if (loSize > hiSize + 1) {
+            hi.push(lo.top()); lo.pop();
+            loSize--; hiSize++;
+            prune(lo);
+        } else if (loSize < hiSize) {
+            lo.push(hi.top()); hi.pop();
+            hiSize--; loSize++;
+            prune(hi);
+        }
+    }
+
+public:
+    // O(log N)
+    void insert(Key value) {
+        if (lo.empty() || !comp(lo.top(), value)) { lo.push(value); loSize++; }
+        else { hi.push(value); hiSize++; }
+        rebalance();
+    }
+
+    // O(log N) amortizado; o valor tem que existir (quem chama garante)
+    void remove(Key value) {
+        delayed[value]++;
+        if (!comp(lo.top(), value)) {
+            loSize--;
+            if (value == lo.top()) prune(lo);
+        } else {
+            hiSize--;
+            if (value == hi.top()) prune(hi);
+        }
+        rebalance();
+    }
+
+    // O(1)
+    double median() {
+        if (loSize == 0) return 0.0;
+        if (loSize > hiSize) return lo.top();
+        return ((double)lo.top() + hi.top()) / 2.0;
+    }
+};
+
+// Alocador alinhado na linha de cache (o vector padrão só garante 16 bytes)
+template <typename T, size_t Alinhamento = 64>
+struct AlocadorAlinhado {
+    using value_type = T;
+    template <typename U> struct rebind { using other = AlocadorAlinhado<U, Alinhamento>; };
+
+    AlocadorAlinhado() = default;
+    template <typename U> AlocadorAlinhado(const AlocadorAlinhado<U, Alinhamento>&) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alinhamento))); }
+    void deallocate(T* p, size_t) { ::operator delete(p, std::align_val_t(Alinhamento)); }
+
+    template <typename U> bool operator==(const AlocadorAlinhado<U, Alinhamento>&) const { return true; }
+};
+
+// Heap mínimo d-ário (Aridade filhos por nó; 2, 4 ou 8)
+// Com mais filhos a árvore fica mais baixa (log_d N níveis) e os d filhos de um nó são
+// vizinhos no vetor. O vetor começa alinhado em 64 bytes e com Aridade - 1 posições
+// sobrando na frente, então os filhos de todo nó começam num múltiplo de Aridade: com
+// Aridade * sizeof(Key) <= 64 eles ficam numa linha de cache só (4 ou 8 doubles).
+template <typename Key = double, typename Compare = std::less<Key>, int Aridade = 4>
+class PureMinHeap {
+    static_assert(Aridade >= 2, "heap precisa de pelo menos 2 filhos por nó");
+
+public:
+    using key_type = Key;
+    using key_compare = Compare;
+    static const int ARIDADE = Aridade;
+
+private:
+    static const size_t FOLGA = Aridade - 1; // posições sem uso no começo do vetor
+    std::vector<Key, AlocadorAlinhado<Key>> heap;
+    bool streaming;         // se true, mantém a mediana em O(1)
+    StreamingMedian<Key, Compare> stream;
+    Compare comp;
+
+    // Índices lógicos (raiz = 0); os filhos de i são Aridade*i + 1 ... Aridade*i + Aridade
+    Key* dados() { return heap.data() + FOLGA; }
+    size_t tamanho() const { return heap.size() - FOLGA; }
+
+    // Sobe o elemento até ficar no lugar certo (abre um buraco e desce os pais, sem swap)
+    void siftUp(size_t i) {
+        Key* h = dados();
+        Key v = h[i];
+        while (i > 0) {
+            size_t p = (i - 1) / Aridade;
+            if (!comp(v, h[p])) break;
+            h[i] = h[p];
+            i = p;
+        }
+        h[i] = v;
+    }
+
+    // Desce o elemento até ficar no lugar certo: acha o menor dos filhos (mesma linha de cache)
+    // e sobe ele pro buraco; o valor só é escrito uma vez, no fim
+    void siftDown(size_t i) {
+        Key* h = dados();
+        size_t n = tamanho();
+        Key v = h[i];
+        while (true) {
+            size_t c = Aridade * i + 1;
+            if (c >= n) break;
+            size_t fim = std::min(c + Aridade, n);
+            size_t menor = c;
+            for (size_t j = c + 1; j < fim; j++) {
+                if (comp(h[j], h[menor])) menor = j;
+            }
+            if (!comp(h[menor], v)) break;
+            h[i] = h[menor];
+            i = menor;
+        }
+        h[i] = v;
+    }
+
+    // Floyd: desce cada nó interno, do último pro primeiro. O(N)
+    void heapify() {
+        size_t n = tamanho();
+        if (n < 2) return;
+        for (size_t i = (n - 2) / Aridade + 1; i-- > 0; ) siftDown(i);
+    }
+
+    // Nenhum filho menor que o pai
+    bool ehHeap() {
+        const Key* h = dados();
+        for (size_t i = 1; i < tamanho(); i++) {
+            if (comp(h[i], h[(i - 1) / Aridade])) return false;
+        }
+        return true;
+    }
+
+public:
+    // streamingMedian = true liga o modo de mediana ao vivo (dois heaps extras)
+    explicit PureMinHeap(bool streamingMedian = false) : heap(FOLGA), streaming(streamingMedian) {}
+
+    // Adiciona valor no heap
+    void insert(Key value) {
+        heap.push_back(value);
+        siftUp(tamanho() - 1);
+        if (streaming) stream.insert(value);
+    }
+
+    // Troca o conteúdo pelo lote e monta o heap de baixo pra cima em O(N)
+    // (em vez de N inserções de O(log N))
+    void buildFrom(std::span<const Key> valores) {
+        heap.resize(FOLGA);
+        heap.insert(heap.end(), valores.begin(), valores.end());
+        heapify();
+        if (streaming) {
+            stream = StreamingMedian<Key, Compare>();
+            for (Key v : valores) stream.insert(v);
+        }
+    }
+
+    // Lote de valores: se o lote for maior que o heap, junta tudo e refaz o heap de baixo
+    // pra cima em O(N); senão sobe um por um
+    void insertBatch(std::span<const Key> batch) {
+        size_t antes = tamanho();
+        heap.insert(heap.end(), batch.begin(), batch.end());
+        if (batch.size() > antes) heapify();
+        else for (size_t i = antes; i < tamanho(); i++) siftUp(i);
+        if (streaming) for (Key v : batch) stream.insert(v);
+    }
+
+    // Grava o array do heap como está, com a aridade (formato de estado_bin.hpp)
+    bool save(const std::string& arquivo, uint64_t geracaoLog = 0) {
+        return salvarEstado<Key>(arquivo, ESTADO_HEAP, std::span<const Key>(dados(), tamanho()), Aridade, geracaoLog);
+    }
+
+    // Copia o array de volta e confere a propriedade de heap em O(N); se não bater (gravado
+    // com outra aridade ou outro comparador) refaz com Floyd, também O(N).
+    // Arquivo ausente ou inválido não mexe no heap.
+    bool load(const std::string& arquivo) {
+        EstadoMapeado<Key> estado;
+        if (!estado.abrir(arquivo, ESTADO_HEAP)) return false;
+        std::span<const Key> v = estado.valores();
+        heap.resize(FOLGA);
+        heap.insert(heap.end(), v.begin(), v.end());
+        if (estado.extra() != (uint64_t)Aridade || !ehHeap()) heapify();
+        if (streaming) {
+            stream = StreamingMedian<Key, Compare>();
+            for (Key x : v) stream.insert(x);
+        }
+        return true;
+    }
+
+    // Menor valor: O(1)
+    Key top() { return tamanho() == 0 ? Key{} : dados()[0]; }
+
+    // Tira o menor valor: O(Aridade * log_Aridade N)
+    void pop() {
+        if (tamanho() == 0) return;
+        if (streaming) stream.remove(dados()[0]);
+        dados()[0] = heap.back();
+        heap.pop_back();
+        if (tamanho() > 1) siftDown(0);
+    }
+
+    // Remove valor do heap (busca linear O(N))
+    void remove(Key value) {
+        Key* h = dados();
+        size_t n = tamanho();
+        size_t index = std::find(h, h + n, value) - h;
+        if (index == n) return;
+        if (streaming) stream.remove(value);
+        h[index] = heap.back();
+        heap.pop_back();
+        if (index < tamanho()) {
+            siftDown(index);
+            siftUp(index);
+        }
+    }
+
+    // Gera uma cópia ordenada do heap
+    std::vector<Key> getSortedCopy() {
+        std::vector<Key> temp(dados(), dados() + tamanho());
+        std::sort(temp.begin(), temp.end(), comp);
+        return temp;
+    }
+
+    // Calcula a mediana
+    double median() {
+        if (tamanho() == 0) return 0.0;
+        if (streaming) return stream.median();
+        std::vector<Key> temp = getSortedCopy(); // Custo alto: Sort
+        int n = temp.size();
+        if (n % 2 != 0) return temp[n / 2];
+        else return ((double)temp[n / 2 - 1] + temp[n / 2]) / 2.0;
+    }
+
+    // Retorna os n menores valores sem mexer no heap: uma fronteira (heap pequeno de posições)
+    // começa na raiz; cada vez sai a menor posição dela e entram os filhos dessa posição.
+    // O(n * Aridade * log n), não depende de N.
+    std::vector<Key> min(int n) {
+        std::vector<Key> result;
+        size_t total = tamanho();
+        if (n <= 0 || total == 0) return result;
+        n = (int)std::min<size_t>(n, total);
+        const Key* h = dados();
+        auto depois = [&](size_t a, size_t b) { return comp(h[b], h[a]); }; // topo = menor valor
+        std::vector<size_t> fronteira;
+        fronteira.reserve((size_t)n * (Aridade - 1) + 1);
+        fronteira.push_back(0);
+        result.reserve(n);
+        while ((int)result.size() < n && !fronteira.empty()) {
+            std::pop_heap(fronteira.begin(), fronteira.end(), depois);
+            size_t i = fronteira.back();
+            fronteira.pop_back();
+            result.push_back(h[i]);
+            for (size_t c = Aridade * i + 1; c <= Aridade * i + Aridade && c < total; c++) {
+                fronteira.push_back(c);
+                std::push_heap(fronteira.begin(), fronteira.end(), depois);
+            }
+        }
+        return result;
+    }
+
+    // Retorna os n maiores valores (do maior pro menor). O heap mínimo não ajuda aqui, então
+    // é uma passada só guardando os n maiores (partial_sort_copy), O(N log n) sem copiar o heap
+    std::vector<Key> max(int n) {
+        size_t m = std::min<size_t>(std::max(n, 0), tamanho());
+        std::vector<Key> result(m);
+        std::partial_sort_copy(dados(), dados() + tamanho(), result.begin(), result.end(),
+                               [&](const Key& a, const Key& b) { return comp(b, a); });
+        return result;
+    }
+
+    // Versão sem alocação: chama visit(valor) pra cada valor em [x, y]
+    // na ordem do array (sem ordenar nada). visit retorna false pra parar antes. Retorna quantos foram visitados.
+    template <typename F>
+    size_t forEachInRange(Key x, Key y, F&& visit) {
+        size_t n = 0;
+        for (Key val : std::span<const Key>(dados(), tamanho())) {
+            if (dentroDoIntervalo(comp, val, x, y)) {
+                n++;
+                if (!visit(val)) break;
+            }
+        }
+        return n;
+    }
+
+    // Escreve os valores de [x, y] num iterador de saída, parando depois de `limit`
+    template <typename OutIt>
+    OutIt rangeQuery(Key x, Key y, OutIt out, size_t limit = std::numeric_limits<size_t>::max()) {
+        if (limit == 0) return out;
+        size_t n = 0;
+        forEachInRange(x, y, [&](Key v) { *out++ = v; return ++n < limit; });
+        return out;
+    }
+
+    // Conta os valores em [x, y] sem alocar nada (filtro SIMD com double)
+    int rangeCount(Key x, Key y) {
+        return contarNoIntervalo(comp, dados(), tamanho(), x, y);
+    }
+
+    // Busca todos os valores no intervalo, na ordem do array (quem quiser ordenado ordena)
+    std::vector<Key> rangeQuery(Key x, Key y) {
+        return filtrarNoIntervalo(comp, dados(), tamanho(), x, y);
+    }
+
+    int count() { return tamanho(); }
+
+    // Memória do vetor do heap (sem contar os heaps da mediana em streaming)
+    size_t bytesUsed() { return heap.capacity() * sizeof(Key); }
+
+    // Verifica se o heap está vazio
+    bool isEmpty() { return tamanho() == 0; }
+};
+
+// Heap mínimo com índice valor -> posições (aceita valores repetidos).
+// Cada troca no siftUp/siftDown atualiza o índice, então remove(valor) é O(log N).
+template <typename Key = double, typename Compare = std::less<Key>>
+class IndexedMinHeap {
+private:
+    struct Entry {
+        Key value;
+        std::vector<int>* list; // lista de posições desse valor (fica dentro do mapa)
+        int slot;               // índice desta entrada dentro da lista
+    };
+    std::vector<Entry> heap;
+    std::unordered_map<Key, std::vector<int>> pos;
+    Compare comp;
+
+    int parent(int i) { return (i - 1) / 2; }
+    int leftChild(int i) { return (2 * i + 1); }
+    int rightChild(int i) { return (2 * i + 2); }
+
+    // Troca duas posições e corrige o índice das duas
+    void swapNodes(int i, int j) {
+        std::swap(heap[i], heap[j]);
+        (*heap[i].list)[heap[i].slot] = i;
+        (*heap[j].list)[heap[j].slot] = j;
+    }
+
+    void siftUp(int i) {
+        while (i > 0 && comp(heap[i].value, heap[parent(i)].value)) {
+            swapNodes(i, parent(i));
+            i = parent(i);
+        }
+    }
+
+    void siftDown(int i) {
+        int n = heap.size();
+        while (true) {
+            int minIndex = i;
+            int l = leftChild(i);
+            int r = rightChild(i);
+            if (l < n && comp(heap[l].value, heap[minIndex].value)) minIndex = l;
+            if (r < n && comp(heap[r].value, heap[minIndex].value)) minIndex = r;
+            if (minIndex == i) return;
+            swapNodes(i, minIndex);
+            i = minIndex;
+        }
+    }
+
+public:
+    void insert(Key value) {
+        std::vector<int>& list = pos[value];
+        heap.push_back({value, &list, (int)list.size()});
+        list.push_back(heap.size() - 1);
+        siftUp(heap.size() - 1);
+    }
+
+    // Remove uma ocorrência do valor (se existir) sem busca linear
+    void remove(Key value) {
+        auto it = pos.find(value);
+        if (it == pos.end()) return;
+        int index = it->second.back(); // a última ocorrência tem slot == size - 1
+        it->second.pop_back();
+        if (it->second.empty()) pos.erase(it);
+
+        int last = heap.size() - 1;
+        if (index != last) {
+            heap[index] = heap[last];
+            (*heap[index].list)[heap[index].slot] = index;
+        }
+        heap.pop_back();
+
+        if (index < (int)heap.size()) {
+            siftDown(index);
+            siftUp(index);
+        }
+    }
+
+    bool contains(Key value) { return pos.count(value) > 0; }
+    Key top() { return heap.empty() ? Key{} : heap[0].value; }
+    int size() { return heap.size(); }
+    bool isEmpty() { return heap.empty(); }
+};
@@ -0,0 +1,88 @@
+// Bibliotecas que vou usar
+#include <iostream>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <filesystem>
+#include <memory>
+#include <cstdint>
+
+#include "indices.hpp"
+#include "gerador.hpp"
+#include "medicao.hpp"
+
+// Uso: ./restauracao [--n N] [--dir D] [--dist X] [--seed S]
+//   Monta AVL, heap e vetor (adaptativo) com N leituras do gerador (padrão 1000000),
+//   grava o estado de cada um em D (padrão .) e compara as duas formas de voltar depois
+//   de um deploy/queda: reconstruir do zero (N inserções, e a ordenação no vetor) x load()
+//   do estado (mmap + conferir a soma + remontar em O(N)). No fim confere que ficou igual.
+
+template <typename Indice>
+void comparar(const std::string& nome, const std::vector<double>& dados, const std::string& arquivo,
+              bool& iguais, bool ordenarVetor = false) {
+    auto criar = [&] {
+        if constexpr (std::is_same_v<Indice, VectorInsertionSort<>>) return std::make_unique<Indice>(true);
+        else return std::make_unique<Indice>();
+    };
+
+    auto original = criar();
+    double tMontar = cronometrar([&] {
+        for (double v : dados) original->insert(v);
+        if (ordenarVetor) naoOtimizar(original->median()); // o vetor só fica ordenado depois da 1a consulta
+    });
+
+    bool gravou;
+    double tSave = cronometrar([&] { gravou = original->save(arquivo); });
+    if (!gravou) {
+        std::cerr << "Nao consegui gravar " << arquivo << std::endl;
+        iguais = false;
+        return;
+    }
+
+    auto restaurado = criar();
+    bool leu;
+    double tLoad = cronometrar([&] { leu = restaurado->load(arquivo); });
+
+    bool igual = leu && restaurado->count() == original->count() && restaurado->median() == original->median()
+              && restaurado->min(10) == original->min(10) && restaurado->max(10) == original->max(10)
+              && restaurado->rangeCount(20.0, 25.0) == original->rangeCount(20.0, 25.0);
+    iguais &= igual;
+
+    std::cout << std::left << std::setw(10) << nome << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << tMontar / 1e6 << std::setw(12) << tSave / 1e6 << std::setw(12) << tLoad / 1e6
+              << std::setw(10) << std::setprecision(0) << tMontar / tLoad << "x"
+              << std::setw(12) << std::filesystem::file_size(arquivo) / (1024 * 1024) << " MB"
+              << "   " << (igual ? "igual" : "DIFERENTE") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    ConfigGerador gen;
+    gen.n = 1000000;
+    std::string dir = ".";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--n" && temValor) gen.n = (uint64_t)std::stod(argv[++i]);
+        else if (arg == "--dir" && temValor) dir = argv[++i];
+        else if (arg == "--seed" && temValor) gen.semente = std::stoull(argv[++i]);
+        else if (arg == "--dist" && temValor && distribuicaoPorNome(argv[++i], gen.dist)) {}
+        else {
+            std::cerr << "Uso: ./restauracao [--n N] [--dir D] [--dist " << nomesDistribuicoes() << "] [--seed S]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<double> dados = gerarLeituras(gen);
+    std::cout << dados.size() << " leituras, estado gravado em " << dir << "\n\n";
+    std::cout << std::left << std::setw(10) << "Estrutura" << std::right << std::setw(14) << "do zero (ms)"
+              << std::setw(12) << "save (ms)" << std::setw(12) << "load (ms)" << std::setw(11) << "ganho"
+              << std::setw(15) << "arquivo" << std::endl;
+
+    bool iguais = true;
+    comparar<AVLTree<>>("AVL", dados, dir + "/estado_avl.bin", iguais);
+    comparar<PureMinHeap<>>("HEAP", dados, dir + "/estado_heap.bin", iguais);
+    comparar<VectorInsertionSort<>>("VEC(adapt)", dados, dir + "/estado_vetor.bin", iguais, true);
+
+    std::cout << "\nEstado restaurado " << (iguais ? "igual ao original" : "DIFERENTE do original") << std::endl;
+    return iguais ? 0 : 1;
+}
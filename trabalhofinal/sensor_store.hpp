@@ -0,0 +1,328 @@
+// Várias estações: guarda registros (sensor, timestamp, temperatura) com um índice por sensor
+//
+//   SensorStore<AVLTree<>> loja;                 // árvore com select/rank por sensor
+//   SensorStore<FenwickHistogram<>> loja;        // histograma (índice de 42 KB por sensor, O(log D))
+//   loja.insert(17, 1718000000, 22.5);
+//   loja.median(17);   // só o sensor 17
+//   loja.median();     // a frota toda
+//   loja.forEachEntre(17, t0, t1, [](int64_t t, double v) { ... });  // histórico por tempo
+//
+// Cada sensor guarda os valores no índice (pras estatísticas) e os registros inteiros numa
+// coluna de timestamps + uma de valores, em ordem de tempo (pras consultas por período).
+// O histórico custa 8 + sizeof(chave) bytes por leitura, inclusive com o histograma.
+// As consultas da frota inteira não juntam as leituras num vetor: combinam os índices
+// de cada sensor usando rank/select (mediana por seleção em várias sequências ordenadas,
+// min/max por intercalação com heap, range somando/visitando sensor por sensor).
+// A ordem é a crescente (std::less) da chave.
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <queue>
+#include <limits>
+#include <cstdint>
+
+#include "indice.hpp"
+
+template <IndiceOrdenado Indice>
+class SensorStore {
+public:
+    using key_type = typename Indice::key_type;
+    using Fabrica = std::function<std::unique_ptr<Indice>()>;
+
+    struct Registro {
+        uint32_t sensor;
+        int64_t timestamp;
+        key_type temperatura;
+    };
+
+    // O que fica guardado de cada sensor
+    struct Sensor {
+        uint32_t id;
+        std::unique_ptr<Indice> indice;  // os valores, pra mediana/rank/min/max
+        std::vector<int64_t> tempos;     // os registros em ordem de tempo (colunas paralelas)
+        std::vector<key_type> valores;
+
+        int64_t primeiro() const { return tempos.empty() ? 0 : tempos.front(); } // timestamp mais antigo
+        int64_t ultimo() const { return tempos.empty() ? 0 : tempos.back(); }    // timestamp mais novo
+    };
+
+private:
+    static constexpr uint32_t VAZIO = std::numeric_limits<uint32_t>::max();
+
+    // Tabela hash de endereçamento aberto (sondagem linear): id do sensor -> posição em `sensores`.
+    // Só dois uint32 por entrada, capacidade potência de 2 e carga máxima de 70%.
+    std::vector<uint32_t> chaves;
+    std::vector<uint32_t> posicoes;
+    std::vector<Sensor> sensores;
+    Fabrica criar;
+    size_t total = 0;
+
+    static size_t espalhar(uint32_t id) { return (size_t)(id * 0x9E3779B1u); } // hash de Fibonacci
+
+    size_t procurar(uint32_t id) const {
+        size_t mascara = chaves.size() - 1;
+        size_t i = espalhar(id) & mascara;
+        while (posicoes[i] != VAZIO && chaves[i] != id) i = (i + 1) & mascara;
+        return i;
+    }
+
+    void crescer() {
+        std::vector<uint32_t> velhas = std::move(chaves);
+        std::vector<uint32_t> velhasPos = std::move(posicoes);
+        size_t cap = std::max<size_t>(16, velhas.size() * 2);
+        chaves.assign(cap, 0);
+        posicoes.assign(cap, VAZIO);
+        for (size_t i = 0; i < velhas.size(); i++) {
+            if (velhasPos[i] == VAZIO) continue;
+            size_t j = procurar(velhas[i]);
+            chaves[j] = velhas[i];
+            posicoes[j] = velhasPos[i];
+        }
+    }
+
+    // Acha o sensor, criando se ainda não existe
+    Sensor& sensorOuNovo(uint32_t id) {
+        if ((sensores.size() + 1) * 10 > chaves.size() * 7) crescer();
+        size_t i = procurar(id);
+        if (posicoes[i] == VAZIO) {
+            chaves[i] = id;
+            posicoes[i] = (uint32_t)sensores.size();
+            Sensor novo;
+            novo.id = id;
+            novo.indice = criar();
+            sensores.push_back(std::move(novo));
+        }
+        return sensores[posicoes[i]];
+    }
+
+    // k-ésimo menor (k começa em 0) da frota, sem juntar as leituras.
+    // Cada sensor tem uma faixa de posições candidatas [lo, hi). A cada rodada o pivô é a
+    // mediana ponderada (pelo tamanho da faixa) dos meios das faixas: pelo menos 1/4 dos
+    // candidatos sai, então são O(log N) rodadas de O(S log n) cada.
+    key_type selectFrota(size_t k) {
+        size_t S = sensores.size();
+        std::vector<int> lo(S, 0), hi(S), menores(S), iguais(S);
+        for (size_t s = 0; s < S; s++) hi[s] = sensores[s].indice->count();
+        std::vector<std::pair<key_type, size_t>> meios; // (valor do meio, peso)
+
+        while (true) {
+            meios.clear();
+            size_t candidatos = 0;
+            for (size_t s = 0; s < S; s++) {
+                if (lo[s] >= hi[s]) continue;
+                size_t peso = hi[s] - lo[s];
+                meios.push_back({sensores[s].indice->select(lo[s] + (hi[s] - lo[s]) / 2), peso});
+                candidatos += peso;
+            }
+            std::sort(meios.begin(), meios.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+            key_type pivo = meios.back().first;
+            size_t acumulado = 0;
+            for (const auto& m : meios) {
+                acumulado += m.second;
+                if (acumulado * 2 >= candidatos) { pivo = m.first; break; }
+            }
+
+            // Quantos valores da frota são menores e iguais ao pivô
+            size_t abaixo = 0, noPivo = 0;
+            for (size_t s = 0; s < S; s++) {
+                Indice& idx = *sensores[s].indice;
+                menores[s] = idx.rank(pivo);
+                iguais[s] = idx.rangeCount(pivo, pivo);
+                abaixo += menores[s];
+                noPivo += iguais[s];
+            }
+            if (k < abaixo) {
+                for (size_t s = 0; s < S; s++) hi[s] = std::min(hi[s], menores[s]);
+            } else if (k < abaixo + noPivo) {
+                return pivo;
+            } else {
+                for (size_t s = 0; s < S; s++) lo[s] = std::max(lo[s], menores[s] + iguais[s]);
+            }
+        }
+    }
+
+    // Intercala os sensores pelas pontas: cada sensor entra no heap com o próximo valor
+    // (select na posição seguinte), então só lê os n valores que saem
+    std::vector<key_type> intercalar(int n, bool maiores) {
+        std::vector<key_type> res;
+        if (n <= 0) return res;
+        using Item = std::pair<key_type, std::pair<size_t, int>>; // (valor, (sensor, quantos já saíram))
+        auto depois = [maiores](const Item& a, const Item& b) { return maiores ? a.first < b.first : b.first < a.first; };
+        std::priority_queue<Item, std::vector<Item>, decltype(depois)> fila(depois);
+        auto proximo = [&](size_t s, int j) {
+            Indice& idx = *sensores[s].indice;
+            int c = (int)idx.count();
+            if (j < c) fila.push({idx.select(maiores ? c - 1 - j : j), {s, j}});
+        };
+        for (size_t s = 0; s < sensores.size(); s++) proximo(s, 0);
+        res.reserve(std::min<size_t>(n, total));
+        while (!fila.empty() && (int)res.size() < n) {
+            Item it = fila.top();
+            fila.pop();
+            res.push_back(it.first);
+            proximo(it.second.first, it.second.second + 1);
+        }
+        return res;
+    }
+
+    Sensor* achar(uint32_t id) {
+        if (chaves.empty()) return nullptr;
+        size_t i = procurar(id);
+        return posicoes[i] == VAZIO ? nullptr : &sensores[posicoes[i]];
+    }
+
+public:
+    explicit SensorStore(Fabrica f = [] { return std::make_unique<Indice>(); }) : criar(std::move(f)) {}
+
+    // O(log n) no índice + O(1) no histórico quando o timestamp não volta no tempo (o normal);
+    // leitura atrasada entra no lugar certo da coluna, O(n) no pior caso.
+    // false = o índice do sensor recusou o valor (o histograma recusa fora da faixa)
+    bool insert(uint32_t sensor, int64_t timestamp, key_type valor) {
+        Sensor& s = sensorOuNovo(sensor);
+        size_t antes = s.indice->count();
+        s.indice->insert(valor);
+        if ((size_t)s.indice->count() == antes) return false;
+        if (s.tempos.empty() || timestamp >= s.tempos.back()) {
+            s.tempos.push_back(timestamp);
+            s.valores.push_back(valor);
+        } else {
+            size_t i = std::upper_bound(s.tempos.begin(), s.tempos.end(), timestamp) - s.tempos.begin();
+            s.tempos.insert(s.tempos.begin() + i, timestamp);
+            s.valores.insert(s.valores.begin() + i, valor);
+        }
+        total++;
+        return true;
+    }
+    bool insert(const Registro& r) { return insert(r.sensor, r.timestamp, r.temperatura); }
+
+    // Tira o registro (sensor, timestamp, valor), se tiver: acha pelo timestamp em O(log n)
+    bool remove(uint32_t sensor, int64_t timestamp, key_type valor) {
+        Sensor* s = achar(sensor);
+        if (s == nullptr) return false;
+        auto [ini, fim] = std::equal_range(s->tempos.begin(), s->tempos.end(), timestamp);
+        for (auto it = ini; it != fim; ++it) {
+            size_t i = it - s->tempos.begin();
+            if (s->valores[i] != valor) continue;
+            s->indice->remove(valor);
+            s->tempos.erase(it);
+            s->valores.erase(s->valores.begin() + i);
+            total--;
+            return true;
+        }
+        return false;
+    }
+    bool remove(const Registro& r) { return remove(r.sensor, r.timestamp, r.temperatura); }
+
+    // Índice de um sensor (nullptr se ele nunca mandou leitura): pra usar o resto da API dele
+    Indice* indice(uint32_t sensor) {
+        Sensor* s = achar(sensor);
+        return s ? s->indice.get() : nullptr;
+    }
+    const Sensor* info(uint32_t sensor) { return achar(sensor); }
+    const std::vector<Sensor>& todos() const { return sensores; }
+
+    size_t sensorCount() const { return sensores.size(); }
+    size_t count() const { return total; }
+    size_t count(uint32_t sensor) {
+        Sensor* s = achar(sensor);
+        return s ? s->indice->count() : 0;
+    }
+    bool isEmpty() const { return total == 0; }
+
+    // ---- Um sensor ----
+    double median(uint32_t sensor) {
+        Sensor* s = achar(sensor);
+        return s ? s->indice->median() : 0.0;
+    }
+    std::vector<key_type> rangeQuery(uint32_t sensor, key_type x, key_type y) {
+        Sensor* s = achar(sensor);
+        return s ? s->indice->rangeQuery(x, y) : std::vector<key_type>{};
+    }
+    int rangeCount(uint32_t sensor, key_type x, key_type y) {
+        Sensor* s = achar(sensor);
+        return s ? s->indice->rangeCount(x, y) : 0;
+    }
+
+    // Chama visit(timestamp, valor) pros registros do sensor com timestamp em [t0, t1], em
+    // ordem de tempo. visit retorna false pra parar. Retorna quantos visitou. O(log n + k).
+    template <typename F>
+    size_t forEachEntre(uint32_t sensor, int64_t t0, int64_t t1, F&& visit) {
+        Sensor* s = achar(sensor);
+        if (s == nullptr || t0 > t1) return 0;
+        size_t i = std::lower_bound(s->tempos.begin(), s->tempos.end(), t0) - s->tempos.begin();
+        size_t n = 0;
+        for (; i < s->tempos.size() && s->tempos[i] <= t1; i++) {
+            n++;
+            if (!visit(s->tempos[i], s->valores[i])) break;
+        }
+        return n;
+    }
+
+    // Os registros do sensor com timestamp em [t0, t1]
+    std::vector<Registro> registros(uint32_t sensor, int64_t t0, int64_t t1) {
+        std::vector<Registro> res;
+        forEachEntre(sensor, t0, t1, [&](int64_t t, key_type v) { res.push_back({sensor, t, v}); return true; });
+        return res;
+    }
+    std::vector<key_type> min(uint32_t sensor, int n) {
+        Sensor* s = achar(sensor);
+        return s ? s->indice->min(n) : std::vector<key_type>{};
+    }
+    std::vector<key_type> max(uint32_t sensor, int n) {
+        Sensor* s = achar(sensor);
+        return s ? s->indice->max(n) : std::vector<key_type>{};
+    }
+
+    // ---- Frota inteira ----
+    key_type select(size_t k) { return (k < total) ? selectFrota(k) : key_type{}; }
+
+    double median() {
+        if (total == 0) return 0.0;
+        if (total % 2 != 0) return selectFrota(total / 2);
+        return ((double)selectFrota(total / 2 - 1) + selectFrota(total / 2)) / 2.0;
+    }
+
+    int rangeCount(key_type x, key_type y) {
+        int c = 0;
+        for (Sensor& s : sensores) c += s.indice->rangeCount(x, y);
+        return c;
+    }
+
+    // Chama visit(sensor, valor) pra cada leitura em [x, y], sensor por sensor
+    // (crescente dentro de cada sensor). visit retorna false pra parar. Retorna quantos visitou.
+    template <typename F>
+    size_t forEachInRange(key_type x, key_type y, F&& visit) {
+        size_t n = 0;
+        bool parar = false;
+        for (Sensor& s : sensores) {
+            n += s.indice->forEachInRange(x, y, [&](key_type v) { return !(parar = !visit(s.id, v)); });
+            if (parar) break;
+        }
+        return n;
+    }
+
+    // Valores de [x, y] de todos os sensores (agrupados por sensor, não ordenados entre eles)
+    std::vector<key_type> rangeQuery(key_type x, key_type y) {
+        std::vector<key_type> res;
+        res.reserve(rangeCount(x, y));
+        for (Sensor& s : sensores) s.indice->rangeQuery(x, y, std::back_inserter(res));
+        return res;
+    }
+
+    std::vector<key_type> min(int n) { return intercalar(n, false); }
+    std::vector<key_type> max(int n) { return intercalar(n, true); }
+
+    // Memória dos índices (quando eles sabem dizer), do histórico, da tabela hash e da lista de sensores
+    size_t bytesUsed() {
+        size_t b = chaves.capacity() * sizeof(uint32_t) * 2 + sensores.capacity() * sizeof(Sensor);
+        for (Sensor& s : sensores) {
+            b += s.tempos.capacity() * sizeof(int64_t) + s.valores.capacity() * sizeof(key_type);
+            if constexpr (requires { s.indice->bytesUsed(); }) b += s.indice->bytesUsed();
+            else b += sizeof(Indice);
+        }
+        return b;
+    }
+};
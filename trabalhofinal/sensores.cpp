@@ -0,0 +1,112 @@
+// Bibliotecas que vou usar
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <chrono>   // pra medir tempo
+#include <cstdint>
+
+#include "indices.hpp"
+#include "gerador.hpp"
+
+// Uso: ./sensores [--sensores S] [--leituras L] [--dist D]
+//   S sensores (padrão 1000), cada um com L leituras (padrão 1000) de uma distribuição
+//   do gerador.hpp (padrão passeio), uma leitura por minuto
+//
+// Monta a mesma frota com AVL e com histograma por sensor, responde consultas de um
+// sensor e da frota inteira, e compara a mediana da frota com o jeito ingênuo
+// (copiar tudo num vetor e usar nth_element).
+
+template <typename Loja>
+void consultar(const std::string& nome, Loja& loja, uint32_t exemplo) {
+    using Relogio = std::chrono::high_resolution_clock;
+    auto t0 = Relogio::now();
+    double mediana = loja.median();
+    auto t1 = Relogio::now();
+    std::vector<typename Loja::key_type> frios = loja.min(5);
+    std::vector<typename Loja::key_type> quentes = loja.max(5);
+    auto t2 = Relogio::now();
+    int calor = loja.rangeCount(18.0, 45.0);
+    auto t3 = Relogio::now();
+
+    std::cout << "\n[" << nome << "] " << loja.sensorCount() << " sensores, " << loja.count()
+              << " leituras, " << loja.bytesUsed() / 1024 << " KB" << std::endl;
+    std::cout << "  Sensor " << exemplo << ": mediana " << loja.median(exemplo) << ", "
+              << loja.rangeCount(exemplo, 18.0, 45.0) << " leituras em [18, 45]" << std::endl;
+    // Histórico por tempo: a última hora do sensor de exemplo
+    int64_t fim = loja.info(exemplo)->ultimo();
+    double somaHora = 0;
+    size_t naHora = loja.forEachEntre(exemplo, fim - 3599, fim, [&](int64_t, auto v) { somaHora += v; return true; });
+    std::cout << "  Sensor " << exemplo << ", ultima hora: " << naHora << " leituras, media "
+              << (naHora ? somaHora / naHora : 0.0) << std::endl;
+    std::cout << "  Frota: mediana " << mediana << " ("
+              << std::chrono::duration<double, std::micro>(t1 - t0).count() << " us)" << std::endl;
+    std::cout << "  5 mais frias:";
+    for (auto v : frios) std::cout << " " << v;
+    std::cout << " | 5 mais quentes:";
+    for (auto v : quentes) std::cout << " " << v;
+    std::cout << " (" << std::chrono::duration<double, std::micro>(t2 - t1).count() << " us)" << std::endl;
+    std::cout << "  Leituras em [18, 45]: " << calor << " ("
+              << std::chrono::duration<double, std::micro>(t3 - t2).count() << " us)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t numSensores = 1000;
+    size_t porSensor = 1000;
+    ConfigGerador cfg;
+    cfg.dist = Distribuicao::Passeio;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--sensores" && temValor) numSensores = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--leituras" && temValor) porSensor = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--dist" && temValor && distribuicaoPorNome(argv[++i], cfg.dist)) {}
+        else {
+            std::cerr << "Uso: ./sensores [--sensores S] [--leituras L] [--dist " << nomesDistribuicoes() << "]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Cada sensor tem a própria semente; os ids são espalhados (não 0..S-1) pra exercitar a tabela hash
+    std::vector<std::vector<double>> leituras(numSensores);
+    cfg.n = porSensor;
+    for (uint32_t s = 0; s < numSensores; s++) {
+        cfg.semente = 1000 + s;
+        leituras[s] = gerarLeituras(cfg, 1);
+    }
+    auto idSensor = [](uint32_t s) { return 100000 + s * 37; };
+    const int64_t inicio = 1718000000;
+
+    SensorStore<AVLTree<>> avls;
+    SensorStore<FenwickHistogram<>> histogramas;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t j = 0; j < porSensor; j++) {
+        for (uint32_t s = 0; s < numSensores; s++) avls.insert(idSensor(s), inicio + 60 * j, leituras[s][j]);
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (size_t j = 0; j < porSensor; j++) {
+        for (uint32_t s = 0; s < numSensores; s++) histogramas.insert(idSensor(s), inicio + 60 * j, leituras[s][j]);
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::cout << "Insercao (intercalando os sensores como chegaria de verdade): AVL "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms | histograma "
+              << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms" << std::endl;
+
+    consultar("AVL por sensor", avls, idSensor(0));
+    consultar("Histograma por sensor", histogramas, idSensor(0));
+
+    // Jeito ingênuo: junta tudo e acha a mediana
+    auto t3 = std::chrono::high_resolution_clock::now();
+    std::vector<double> tudo;
+    tudo.reserve((size_t)numSensores * porSensor);
+    for (auto& l : leituras) tudo.insert(tudo.end(), l.begin(), l.end());
+    size_t meio = tudo.size() / 2;
+    std::nth_element(tudo.begin(), tudo.begin() + meio, tudo.end());
+    double mediana = tudo[meio];
+    if (tudo.size() % 2 == 0) mediana = (mediana + *std::max_element(tudo.begin(), tudo.begin() + meio)) / 2.0;
+    auto t4 = std::chrono::high_resolution_clock::now();
+    std::cout << "\n[Copiando tudo + nth_element] mediana " << mediana << " ("
+              << std::chrono::duration<double, std::micro>(t4 - t3).count() << " us)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Bibliotecas que vou usar
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <random>
+#include <iomanip>
+
+#include "indices.hpp"
+#include "snapshot_estatico.hpp"
+#include "medicao.hpp"
+
+// Uso: ./snapshot [--max-n N] [--consultas Q] [--resultados R]
+//   varre N = 1e5, 1e6, 1e7 ... até N (padrão 1e7; a AVL com 1e7 nós já passa de 600 MB,
+//   bem mais que o cache L3), com Q consultas aleatórias (padrão 1000000) e faixas com
+//   ~R valores em média (padrão 10)
+//
+// A AVL é montada inserindo uma a uma na ordem de chegada, como no uso normal (com
+// bulkLoad os nós sairiam do malloc já em ordem e a árvore ficaria artificialmente
+// amigável ao cache). O snapshot é montado com getSortedList() dela.
+// Os valores são contínuos (sem arredondar em 2 casas) pra cada busca cair num lugar diferente.
+
+template <typename F>
+double nsPorConsulta(size_t q, F&& rodada) {
+    std::vector<double> amostras;
+    repetir(ConfigMedicao{1, 5, 3.0}, [&](bool valendo) {
+        double ns = cronometrar(rodada);
+        if (valendo) amostras.push_back(ns / q);
+    });
+    return resumir(amostras).mediana;
+}
+
+// Larguras das colunas (cabeçalho e linhas usam as mesmas pra ficarem alinhados)
+const int COL_OP = 22, COL_NUM = 12, COL_STD = 18, COL_GANHO = 11;
+
+void cabecalhoTabela() {
+    std::cout << std::left << std::setw(COL_OP) << "ns por consulta" << std::right << std::setw(COL_NUM) << "AVL"
+              << std::setw(COL_NUM) << "Snapshot" << std::setw(COL_STD) << "std::lower_bound"
+              << std::setw(COL_GANHO) << "ganho" << std::endl;
+}
+
+void linha(const std::string& op, double avl, double snap, double stdlb) {
+    std::cout << std::left << std::setw(COL_OP) << op << std::right << std::fixed << std::setprecision(1)
+              << std::setw(COL_NUM) << avl << std::setw(COL_NUM) << snap;
+    if (stdlb >= 0) std::cout << std::setw(COL_STD) << stdlb;
+    else std::cout << std::setw(COL_STD) << "-";
+    std::cout << std::setw(COL_GANHO - 1) << std::setprecision(2) << avl / snap << "x" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t maxN = 10000000;
+    size_t Q = 1000000;
+    double resultados = 10;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        if (arg == "--max-n" && temValor) maxN = (size_t)std::stod(argv[++i]);
+        else if (arg == "--consultas" && temValor) Q = std::max<size_t>(1, (size_t)std::stod(argv[++i]));
+        else if (arg == "--resultados" && temValor) resultados = std::stod(argv[++i]);
+        else {
+            std::cerr << "Uso: ./snapshot [--max-n N] [--consultas Q] [--resultados R]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> dis(-10.0, 45.0);
+    std::vector<double> consultas(Q);
+    for (double& x : consultas) x = dis(gen);
+
+    for (size_t n = 100000; n <= maxN; n *= 10) {
+        std::vector<double> dados(n);
+        for (double& v : dados) v = dis(gen);
+        double largura = 55.0 * resultados / n;
+
+        AVLTree<> avl;
+        double tMontarAVL = cronometrar([&] { for (double v : dados) avl.insert(v); });
+        std::vector<double> lista;
+        EytzingerSnapshot<> snap;
+        double tMontarSnap = cronometrar([&] {
+            avl.getSortedList(lista);
+            snap = EytzingerSnapshot<>(lista);
+        });
+
+        std::cout << "\n=== N = " << n << " | AVL " << avl.bytesUsed() / (1024 * 1024) << " MB, snapshot "
+                  << snap.bytesUsed() / (1024 * 1024) << " MB | montagem: AVL " << tMontarAVL / 1e6
+                  << " ms, snapshot " << tMontarSnap / 1e6 << " ms ===" << std::endl;
+        cabecalhoTabela();
+
+        // Busca: posição do primeiro >= x
+        double a = nsPorConsulta(Q, [&] {
+            long s = 0;
+            for (double x : consultas) s += avl.rank(x);
+            naoOtimizar(s);
+        });
+        double b = nsPorConsulta(Q, [&] {
+            size_t s = 0;
+            for (double x : consultas) s += snap.lowerBound(x);
+            naoOtimizar(s);
+        });
+        double c = nsPorConsulta(Q, [&] {
+            size_t s = 0;
+            for (double x : consultas) s += std::lower_bound(lista.begin(), lista.end(), x) - lista.begin();
+            naoOtimizar(s);
+        });
+        linha("busca (rank)", a, b, c);
+
+        a = nsPorConsulta(Q, [&] {
+            long s = 0;
+            for (double x : consultas) s += avl.rangeCount(x, x + largura);
+            naoOtimizar(s);
+        });
+        b = nsPorConsulta(Q, [&] {
+            long s = 0;
+            for (double x : consultas) s += snap.rangeCount(x, x + largura);
+            naoOtimizar(s);
+        });
+        linha("rangeCount", a, b, -1);
+
+        a = nsPorConsulta(Q, [&] {
+            size_t s = 0;
+            for (double x : consultas) s += avl.rangeQuery(x, x + largura).size();
+            naoOtimizar(s);
+        });
+        b = nsPorConsulta(Q, [&] {
+            size_t s = 0;
+            for (double x : consultas) s += snap.rangeQuery(x, x + largura).size();
+            naoOtimizar(s);
+        });
+        linha("rangeQuery (vetor)", a, b, -1);
+
+        // Soma os valores da faixa sem copiar: visitante na AVL, span no snapshot
+        a = nsPorConsulta(Q, [&] {
+            double s = 0;
+            for (double x : consultas) avl.forEachInRange(x, x + largura, [&](double v) { s += v; return true; });
+            naoOtimizar(s);
+        });
+        b = nsPorConsulta(Q, [&] {
+            double s = 0;
+            for (double x : consultas) for (double v : snap.rangeView(x, x + largura)) s += v;
+            naoOtimizar(s);
+        });
+        linha("varrer faixa", a, b, -1);
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+// Índice congelado (só leitura) pra dado histórico que não muda mais
+//
+// A AVL segue um ponteiro por nível: numa busca em 1e7 leituras são ~24 acessos
+// dependentes, quase todos fora do cache. Aqui os valores ficam num vetor ordenado,
+// dividido em blocos de 16 (um nó de B+tree implícita, 2 linhas de cache com double), e
+// a primeira chave de cada bloco vai pra um vetor em layout de Eytzinger (a árvore de
+// busca guardada por níveis: filhos de k em 2k e 2k+1).
+//
+// lower_bound: desce a Eytzinger sem desvio (k = 2k + (chave < x)) buscando antes na
+// memória os nós de 4 níveis abaixo, e depois conta sem desvio quantos dos 16 valores
+// do bloco são menores. As faixas saem direto do vetor ordenado (memória contígua).
+//
+//   std::vector<double> lista; avl.getSortedList(lista);
+//   EytzingerSnapshot<> snap(lista);                       // já ordenado: O(N)
+//   snap.rangeCount(20, 25); snap.rangeQuery(20, 25); snap.median();
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <span>
+#include <cstdint>
+#include <bit>
+
+#include "indice.hpp"
+
+template <typename Key = double, typename Compare = std::less<Key>>
+class EytzingerSnapshot {
+public:
+    using key_type = Key;
+    using key_compare = Compare;
+    static const size_t BLOCO = 16; // valores por bloco (folha da B+tree implícita)
+
+private:
+    std::vector<Key> ordenado;      // todos os valores, ordenados por comp
+    std::vector<Key> eytz;          // primeira chave de cada bloco, em Eytzinger (posição 0 não é usada)
+    std::vector<uint32_t> blocoDe;  // posição na Eytzinger -> número do bloco
+    Compare comp;
+
+    // Preenche a Eytzinger com um percurso em ordem: O(número de blocos)
+    size_t montar(size_t k, size_t i) {
+        if (k < eytz.size()) {
+            i = montar(2 * k, i);
+            eytz[k] = ordenado[i * BLOCO];
+            blocoDe[k] = (uint32_t)i++;
+            i = montar(2 * k + 1, i);
+        }
+        return i;
+    }
+
+    // Primeira posição do vetor ordenado onde direita(v) é falso.
+    // direita(v) tem que ser "v fica antes do que procuro" (monótono no vetor ordenado).
+    template <typename P>
+    size_t procurar(P direita) const {
+        size_t n = eytz.size();
+        if (n <= 1) return 0;
+        // Desce até sair da árvore; os bits de k guardam o caminho (1 = foi pra direita)
+        size_t k = 1;
+        while (k < n) {
+#if defined(__GNUC__) || defined(__clang__)
+            // os 16 descendentes de 4 níveis abaixo são contíguos (2 linhas de cache com double)
+            if (k * 16 < n) {
+                __builtin_prefetch(eytz.data() + k * 16);
+                __builtin_prefetch(eytz.data() + k * 16 + 15);
+            }
+#endif
+            k = 2 * k + direita(eytz[k]);
+        }
+        // Volta até o último nó em que desceu pra esquerda: é o primeiro bloco cuja primeira
+        // chave não vai pra direita (k == 0: todos vão, então é "depois do último")
+        k >>= std::countr_one(k) + 1;
+        size_t primeiro = (k == 0) ? n - 1 : blocoDe[k];
+        if (primeiro == 0) return 0;
+
+        // A resposta está no bloco anterior (ou logo no começo do primeiro):
+        // conta sem desvio quantos dos 16 ainda vão pra direita
+        size_t ini = (primeiro - 1) * BLOCO;
+        size_t fim = std::min(ini + BLOCO, ordenado.size());
+        size_t c = 0;
+        for (size_t i = ini; i < fim; i++) c += direita(ordenado[i]);
+        return ini + c;
+    }
+
+public:
+    EytzingerSnapshot() = default;
+
+    // Valores já ordenados (ex.: AVLTree::getSortedList); com jaOrdenado = false ordena antes
+    explicit EytzingerSnapshot(std::span<const Key> valores, bool jaOrdenado = true)
+        : ordenado(valores.begin(), valores.end()) {
+        if (!jaOrdenado) std::sort(ordenado.begin(), ordenado.end(), comp);
+        size_t blocos = (ordenado.size() + BLOCO - 1) / BLOCO;
+        eytz.resize(blocos + 1);
+        blocoDe.resize(blocos + 1);
+        montar(1, 0);
+    }
+
+    // Primeiro valor >= x e primeiro valor > x (posições no vetor ordenado): O(log N)
+    size_t lowerBound(Key x) const { return procurar([&](const Key& v) { return comp(v, x); }); }
+    size_t upperBound(Key x) const { return procurar([&](const Key& v) { return !comp(x, v); }); }
+
+    size_t count() const { return ordenado.size(); }
+    bool isEmpty() const { return ordenado.empty(); }
+
+    Key select(size_t k) const { return ordenado[k]; }
+    int rank(Key x) const { return (int)lowerBound(x); }
+
+    double median() const {
+        size_t n = ordenado.size();
+        if (n == 0) return 0.0;
+        if (n % 2 != 0) return ordenado[n / 2];
+        return ((double)ordenado[n / 2 - 1] + ordenado[n / 2]) / 2.0;
+    }
+
+    double percentile(double p) const {
+        size_t n = ordenado.size();
+        if (n == 0) return 0.0;
+        double pos = std::clamp(p, 0.0, 100.0) / 100.0 * (n - 1);
+        size_t lo = (size_t)pos;
+        if (lo + 1 >= n) return ordenado[n - 1];
+        double frac = pos - lo;
+        return ordenado[lo] * (1.0 - frac) + ordenado[lo + 1] * frac;
+    }
+
+    // Quantos valores em [x, y]: duas buscas
+    int rangeCount(Key x, Key y) const {
+        if (comp(y, x)) return 0;
+        return (int)(upperBound(y) - lowerBound(x));
+    }
+
+    // Os valores de [x, y] são um pedaço contíguo do vetor: devolve sem copiar
+    std::span<const Key> rangeView(Key x, Key y) const {
+        if (comp(y, x)) return {};
+        size_t a = lowerBound(x), b = upperBound(y);
+        return std::span<const Key>(ordenado.data() + a, b - a);
+    }
+
+    std::vector<Key> rangeQuery(Key x, Key y) const {
+        std::span<const Key> s = rangeView(x, y);
+        return std::vector<Key>(s.begin(), s.end());
+    }
+
+    template <typename OutIt>
+    OutIt rangeQuery(Key x, Key y, OutIt out, size_t limit = std::numeric_limits<size_t>::max()) const {
+        std::span<const Key> s = rangeView(x, y);
+        return std::copy_n(s.begin(), std::min(limit, s.size()), out);
+    }
+
+    // Chama visit(valor) em ordem crescente; visit retorna false pra parar. Retorna quantos visitou.
+    template <typename F>
+    size_t forEachInRange(Key x, Key y, F&& visit) const {
+        size_t n = 0;
+        for (const Key& v : rangeView(x, y)) {
+            n++;
+            if (!visit(v)) break;
+        }
+        return n;
+    }
+
+    std::vector<Key> min(int n) const {
+        size_t m = std::min<size_t>(std::max(n, 0), ordenado.size());
+        return std::vector<Key>(ordenado.begin(), ordenado.begin() + m);
+    }
+
+    std::vector<Key> max(int n) const {
+        size_t m = std::min<size_t>(std::max(n, 0), ordenado.size());
+        return std::vector<Key>(ordenado.rbegin(), ordenado.rbegin() + m);
+    }
+
+    const std::vector<Key>& valores() const { return ordenado; }
+
+    size_t bytesUsed() const {
+        return ordenado.capacity() * sizeof(Key) + eytz.capacity() * sizeof(Key) + blocoDe.capacity() * sizeof(uint32_t);
+    }
+};
@@ -5,121 +5,32 @@
 #include <fstream>
 #include <chrono>
 #include <iomanip>
+#include <limits>
+#include <random>
 
-// Classe do vetor com Insertion Sort
-class VectorInsertionSort {
-private:
-    std::vector<double> data;
-    bool sorted = false;
-
-    // Insertion Sort (bem lento pra muitos dados)
-    void runInsertionSort() {
-        int n = data.size();
-        for (int i = 1; i < n; i++) {
-            double key = data[i];
-            int j = i - 1;
-            while (j >= 0 && data[j] > key) {
-                data[j + 1] = data[j];
-                j = j - 1;
-            }
-            data[j + 1] = key;
-        }
-        sorted = true;
-    }
-
-public:
-    // Adiciona valor (super rápido)
-    void insert(double value) {
-        data.push_back(value);
-        sorted = false; 
-    }
-
-    // Remove valor (O(N))
-    void remove(double value) {
-        for (auto it = data.begin(); it != data.end(); ++it) {
-            if (*it == value) {
-                data.erase(it);
-                return;
-            }
-        }
-    }
-
-    // Calcula a mediana (faz o sort se precisar)
-    double median() {
-        if (data.empty()) return 0.0;
-        if (!sorted) runInsertionSort();
-
-        int n = data.size();
-        if (n % 2 != 0) return data[n / 2];
-        else return (data[n / 2 - 1] + data[n / 2]) / 2.0;
-    }
-
-    // Busca todos os valores no intervalo [x, y]
-    std::vector<double> rangeQuery(double x, double y) {
-        std::vector<double> result;
-        for (double val : data) {
-            if (val >= x && val <= y) {
-                result.push_back(val);
-            }
-        }
-        return result;
-    }
-
-    // Retorna cópia ordenada do vetor
-    std::vector<double> getSortedList() {
-        if (!sorted) runInsertionSort();
-        return data;
-    }
-
-    // Retorna os n menores valores
-    std::vector<double> min(int n) {
-        if (!sorted) runInsertionSort();
-        std::vector<double> res;
-        for(int i=0; i<n && i<(int)data.size(); i++) res.push_back(data[i]);
-        return res;
-    }
-
-    // Retorna os n maiores valores
-    std::vector<double> max(int n) {
-        if (!sorted) runInsertionSort();
-        std::vector<double> res;
-        int sz = data.size();
-        for(int i=0; i<n && i<sz; i++) res.push_back(data[sz - 1 - i]);
-        return res;
-    }
-
-    // Verifica se o vetor está vazio
-    bool isEmpty() { return data.empty(); }
-};
+#include "leituras_bin.hpp"
+#include "indices.hpp"
 
 int main() {
     VectorInsertionSort vec;
-    std::string filename = "temperaturas.csv";
-    std::ifstream file(filename);
-    std::string line;
-    int count = 0;
-
-    if (!file.is_open()) {
-        std::cerr << "Erro ao abrir " << filename << std::endl;
+    // temperaturas.bin mapeado (sem parse) se existir, senão temperaturas.csv
+    Dataset ds = carregarLeituras("temperaturas");
+    VisaoLeituras valores = ds.valores;
+    if (valores.empty()) {
+        std::cerr << "Nenhuma temperatura em temperaturas.bin/.csv" << std::endl;
         return 1;
     }
+    int count = valores.size();
 
     std::cout << std::fixed << std::setprecision(5);
     std::cout << "=== BENCHMARK: VECTOR INSERTION SORT (O(N^2)) ===" << std::endl;
 
     // 1. Inserção dos dados (super rápido)
     auto start = std::chrono::high_resolution_clock::now();
-    while (std::getline(file, line)) {
-        try {
-            if (!line.empty() && line.back() == '\r') line.pop_back();
-            vec.insert(std::stod(line));
-            count++;
-        } catch (...) {}
-    }
+    for (double v : valores) vec.insert(v);
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> t_insert = end - start;
     std::cout << "[INSERT] " << count << " registros | Tempo: " << t_insert.count() << " ms" << std::endl;
-    file.close();
 
     if (vec.isEmpty()) return 0;
 
@@ -169,5 +80,62 @@ int main() {
     std::chrono::duration<double, std::milli> t_sort = end - start;
     std::cout << "[PRINTSORTED] Lista de " << sortedList.size() << " itens | Tempo: " << t_sort.count() << " ms" << std::endl;
 
+    // 8. Carga intercalada: mediana a cada 100 leituras novas (Insertion Sort x modo adaptativo)
+    const int total = 20000, intervalo = 100;
+    VectorInsertionSort legado;
+    VectorInsertionSort adaptativo(true);
+    double somaLeg = 0, somaAd = 0; // usa o resultado pra não otimizar fora
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < total; i++) {
+        legado.insert(valores[i % valores.size()]);
+        if ((i + 1) % intervalo == 0) somaLeg += legado.median();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_leg = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < total; i++) {
+        adaptativo.insert(valores[i % valores.size()]);
+        if ((i + 1) % intervalo == 0) somaAd += adaptativo.median();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> t_ad = end - start;
+    std::cout << "[INTERCALADO] " << total << " inserts, mediana a cada " << intervalo
+              << " | Insertion Sort: " << t_leg.count() << " ms | Adaptativo: " << t_ad.count()
+              << " ms" << (somaLeg == somaAd ? "" : " (DIVERGIU!)") << std::endl;
+
+    // 9. Busca linear [20, 30]: laço com push_back x filtro SIMD (1e6 a 1e8 leituras)
+    std::cout << "[RANGE SIMD] usando " << nomeNivelSIMD() << std::endl;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dis(-1000, 4500); // centésimos de grau
+    std::vector<double> grande;
+    for (size_t n : {(size_t)1000000, (size_t)10000000, (size_t)100000000}) {
+        while (grande.size() < n) grande.push_back(dis(gen) / 100.0);
+
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<double> antigo;
+        for (double val : grande) {
+            if (val >= 20.0 && val <= 30.0) antigo.push_back(val);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> t_loop = end - start;
+
+        start = std::chrono::high_resolution_clock::now();
+        size_t c = contarIntervalo(grande.data(), grande.size(), 20.0, 30.0);
+        end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> t_count = end - start;
+
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<double> novo(contarIntervalo(grande.data(), grande.size(), 20.0, 30.0) + FILTRO_FOLGA);
+        novo.resize(filtrarIntervalo(grande.data(), grande.size(), 20.0, 30.0, novo.data()));
+        end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> t_simd = end - start;
+
+        std::cout << "  N=" << n << " | loop push_back: " << t_loop.count() << " ms | rangeCount: "
+                  << t_count.count() << " ms | rangeQuery SIMD: " << t_simd.count() << " ms"
+                  << ((novo == antigo && c == antigo.size()) ? "" : " (DIVERGIU!)") << std::endl;
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,218 @@
+// Vetor + Insertion Sort dos benchmarks
+// Insere no fim e só ordena quando precisa (mediana, min/max, lista ordenada).
+// No modo adaptativo mantém um prefixo ordenado e intercala só a cauda nova.
+// save/load gravam o vetor como está (com o tamanho do prefixo ordenado).
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string>
+#include <span>
+#include <cstdint>
+
+#include "indice.hpp"
+#include "estado_bin.hpp"
+
+// Classe do vetor com Insertion Sort
+template <typename Key = double, typename Compare = std::less<Key>>
+class VectorInsertionSort {
+public:
+    using key_type = Key;
+    using key_compare = Compare;
+
+private:
+    std::vector<Key> data;
+    bool sorted = false;
+    bool adaptive;          // modo adaptativo: prefixo ordenado + cauda nova
+    size_t sortedCount = 0; // data[0, sortedCount) já está ordenado (o modo adaptativo intercala a partir daí)
+    Compare comp;
+
+    // Insertion Sort (bem lento pra muitos dados)
+    void runInsertionSort() {
+        int n = data.size();
+        for (int i = 1; i < n; i++) {
+            Key key = data[i];
+            int j = i - 1;
+            while (j >= 0 && comp(key, data[j])) {
+                data[j + 1] = data[j];
+                j = j - 1;
+            }
+            data[j + 1] = key;
+        }
+        sortedCount = n;
+        sorted = true;
+    }
+
+    // Modo adaptativo: ordena só a cauda nova e intercala com o prefixo.
+    // Custa O(k log k + N) em vez de O(N^2) quando chegam k leituras novas.
+    void mergeTail() {
+        auto mid = data.begin() + sortedCount;
+        std::sort(mid, data.end(), comp);
+        std::inplace_merge(data.begin(), mid, data.end(), comp);
+        sortedCount = data.size();
+        sorted = true;
+    }
+
+    // Garante o vetor ordenado usando o algoritmo do modo escolhido
+    void ensureSorted() {
+        if (sorted) return;
+        if (adaptive) mergeTail();
+        else runInsertionSort();
+    }
+
+    // Os n primeiros segundo `antes` sem ordenar o vetor: a parte já ordenada (tudo, ou o
+    // prefixo de antes das últimas inserções) entrega os dela direto da ponta, e do resto sai um
+    // partial_sort_copy O(M log n). Depois intercala os dois pedaços. O vetor não muda.
+    template <typename C>
+    std::vector<Key> pontas(int n, C antes, bool doFim) {
+        size_t k = std::min<size_t>(std::max(n, 0), data.size());
+        size_t pref = sorted ? data.size() : sortedCount;
+        size_t kp = std::min(k, pref);
+        std::vector<Key> doPrefixo(kp);
+        if (doFim) std::copy_n(data.begin() + (pref - kp), kp, doPrefixo.rbegin());
+        else std::copy_n(data.begin(), kp, doPrefixo.begin());
+        if (pref == data.size()) return doPrefixo;
+
+        std::vector<Key> doResto(std::min(k, data.size() - pref));
+        std::partial_sort_copy(data.begin() + pref, data.end(), doResto.begin(), doResto.end(), antes);
+        std::vector<Key> res;
+        res.reserve(k);
+        size_t i = 0, j = 0;
+        while (res.size() < k) {
+            if (j == doResto.size() || (i < kp && !antes(doResto[j], doPrefixo[i]))) res.push_back(doPrefixo[i++]);
+            else res.push_back(doResto[j++]);
+        }
+        return res;
+    }
+
+public:
+    // adaptiveMode = true liga o modo prefixo ordenado + cauda (sem Insertion Sort)
+    explicit VectorInsertionSort(bool adaptiveMode = false) : adaptive(adaptiveMode) {}
+
+    // Adiciona valor (super rápido)
+    void insert(Key value) {
+        data.push_back(value);
+        sorted = false;
+    }
+
+    // Remove valor (O(N))
+    void remove(Key value) {
+        if (adaptive) {
+            // Busca binária no prefixo ordenado, linear só na cauda
+            auto tail = data.begin() + sortedCount;
+            auto it = std::lower_bound(data.begin(), tail, value, comp);
+            if (it != tail && *it == value) {
+                data.erase(it);
+                sortedCount--;
+            } else {
+                auto t = std::find(tail, data.end(), value);
+                if (t == data.end()) return;
+                *t = data.back(); // a cauda não tem ordem, troca com o último
+                data.pop_back();
+            }
+            sorted = (sortedCount == data.size());
+            return;
+        }
+        for (auto it = data.begin(); it != data.end(); ++it) {
+            if (*it == value) {
+                if ((size_t)(it - data.begin()) < sortedCount) sortedCount--;
+                data.erase(it);
+                return;
+            }
+        }
+    }
+
+    // Mediana (fica lento se não estiver ordenado)
+    double median() {
+        if (data.empty()) return 0.0;
+        ensureSorted();
+
+        int n = data.size();
+        if (n % 2 != 0) return data[n / 2];
+        else return ((double)data[n / 2 - 1] + data[n / 2]) / 2.0;
+    }
+
+    // Versão sem alocação: chama visit(valor) pra cada valor em [x, y]
+    // na ordem do vetor (crescente se já estiver ordenado). visit retorna false pra parar antes. Retorna quantos foram visitados.
+    template <typename F>
+    size_t forEachInRange(Key x, Key y, F&& visit) {
+        size_t n = 0;
+        if (sorted) {
+            // Já ordenado: começa na busca binária e para no primeiro > y
+            for (auto it = std::lower_bound(data.begin(), data.end(), x, comp); it != data.end() && !comp(y, *it); ++it) {
+                n++;
+                if (!visit(*it)) break;
+            }
+            return n;
+        }
+        for (Key val : data) {
+            if (dentroDoIntervalo(comp, val, x, y)) {
+                n++;
+                if (!visit(val)) break;
+            }
+        }
+        return n;
+    }
+
+    // Escreve os valores de [x, y] num iterador de saída, parando depois de `limit`
+    template <typename OutIt>
+    OutIt rangeQuery(Key x, Key y, OutIt out, size_t limit = std::numeric_limits<size_t>::max()) {
+        if (limit == 0) return out;
+        size_t n = 0;
+        forEachInRange(x, y, [&](Key v) { *out++ = v; return ++n < limit; });
+        return out;
+    }
+
+    // Conta os valores em [x, y] sem alocar nada (filtro SIMD com double)
+    int rangeCount(Key x, Key y) {
+        return contarNoIntervalo(comp, data.data(), data.size(), x, y);
+    }
+
+    // Busca todos os valores no intervalo: conta primeiro e aloca uma vez só
+    std::vector<Key> rangeQuery(Key x, Key y) {
+        return filtrarNoIntervalo(comp, data.data(), data.size(), x, y);
+    }
+
+    // Grava o vetor como está, com o tamanho do prefixo já ordenado (não ordena antes de gravar)
+    bool save(const std::string& arquivo, uint64_t geracaoLog = 0) {
+        return salvarEstado<Key>(arquivo, ESTADO_VETOR, data, sorted ? data.size() : sortedCount, geracaoLog);
+    }
+
+    // Volta o vetor e o prefixo ordenado em O(N); se o prefixo não estiver em ordem pro
+    // comparador daqui, trata tudo como cauda nova. Arquivo ausente ou inválido não mexe no vetor.
+    bool load(const std::string& arquivo) {
+        EstadoMapeado<Key> estado;
+        if (!estado.abrir(arquivo, ESTADO_VETOR)) return false;
+        std::span<const Key> v = estado.valores();
+        size_t pref = std::min<uint64_t>(estado.extra(), v.size());
+        if (!std::is_sorted(v.begin(), v.begin() + pref, comp)) pref = 0;
+        data.assign(v.begin(), v.end());
+        sortedCount = pref;
+        sorted = (pref == data.size());
+        return true;
+    }
+
+    // Retorna cópia ordenada do vetor
+    std::vector<Key> getSortedList() {
+        ensureSorted();
+        return data;
+    }
+
+    // Retorna os n menores valores
+    std::vector<Key> min(int n) { return pontas(n, comp, false); }
+
+    // Retorna os n maiores valores (do maior pro menor)
+    std::vector<Key> max(int n) {
+        return pontas(n, [this](const Key& a, const Key& b) { return comp(b, a); }, true);
+    }
+
+    int count() { return data.size(); }
+
+    // Memória do vetor (capacidade, não só o que está em uso)
+    size_t bytesUsed() { return data.capacity() * sizeof(Key); }
+
+    // Verifica se o vetor está vazio
+    bool isEmpty() { return data.empty(); }
+};